@@ -0,0 +1,207 @@
+#pragma once
+
+// ===========================================
+#include <stddef.h>
+#include <stdint.h>
+// ===========================================
+
+// ===========================================
+/**
+ * @brief C interface to the scanning engine, for tools keeping scans
+ * in-process. Everything is reached through opaque handles, and every
+ * call reports how it went through its status, with what went wrong
+ * left in altdumper_last_error. Nothing thrown crosses it
+ * 
+ * A module, and what's compiled for it, may be used by one thread at
+ * a time. Different modules may be used by different threads at once
+ * 
+ * Additions keep to ALTDUMPER_API_VERSION's layouts, which only change
+ * when it does
+ * 
+ */
+#define ALTDUMPER_API_VERSION 1
+
+#if defined(ALTDUMPER_SHARED)
+#if defined(ALTDUMPER_BUILDING)
+#define ALTDUMPER_API __declspec(dllexport)
+#else
+#define ALTDUMPER_API __declspec(dllimport)
+#endif
+#else
+#define ALTDUMPER_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// ENUMS
+//
+
+typedef enum altdumper_status {
+    ALTDUMPER_OK = 0,
+
+    // what was looked for isn't there
+    ALTDUMPER_NOT_FOUND,
+
+    // a null handle, a malformed pattern and the like
+    ALTDUMPER_INVALID_ARGUMENT,
+
+    // a file that couldn't be read, or isn't an image
+    ALTDUMPER_FAILED
+} altdumper_status;
+
+typedef enum altdumper_kind {
+    ALTDUMPER_SIGNATURE = 0,
+    ALTDUMPER_STRING_SEARCH,
+    ALTDUMPER_PROCEDURE,
+    ALTDUMPER_CONVAR,
+    ALTDUMPER_VTABLE
+} altdumper_kind;
+
+//
+// HANDLES
+//
+
+typedef struct altdumper_snapshot altdumper_snapshot;
+typedef struct altdumper_module altdumper_module;
+typedef struct altdumper_pattern altdumper_pattern;
+
+//
+// DATA
+//
+
+typedef struct altdumper_module_info {
+    // address absolute references inside the image are relative to
+    uint64_t image_base;
+    uint32_t size;
+
+    // 0 for x86, 1 for x64
+    uint32_t x64;
+} altdumper_module_info;
+
+/**
+ * @brief Entry resolved in a batch, like one of a config's. Fields
+ * which don't apply to its kind are ignored
+ * 
+ */
+typedef struct altdumper_entry {
+    altdumper_kind kind;
+
+    // signatures' pattern
+    const altdumper_pattern* pattern;
+
+    // string searched for, procedure, convar or vtable type name
+    const char* name;
+
+    // section scanned, null for the kind's default
+    const char* section;
+
+    // signatures' match and string searches' reference wanted, from 0.
+    // the offset of the vtable wanted, for vtables
+    size_t nth;
+
+    // signatures and string searches, added to what's found, then
+    // dereferenced that many times
+    int32_t padding;
+    uint32_t dereferences;
+
+    // convars, whether to look for the server side one
+    uint32_t server_bounded;
+
+    // filled in, relative address of what was found
+    altdumper_status status;
+    uint32_t rva;
+} altdumper_entry;
+
+//
+// UTILITY
+//
+
+/**
+ * @brief Get version of the interface the library was built with
+ * 
+ * @return uint32_t ALTDUMPER_API_VERSION
+ */
+ALTDUMPER_API uint32_t altdumper_version(void);
+
+/**
+ * @brief Get what went wrong in the last call on this thread that didn't return ALTDUMPER_OK
+ * 
+ * @return const char* Message, valid until the next call on this thread
+ */
+ALTDUMPER_API const char* altdumper_last_error(void);
+
+/**
+ * @brief Open module from a file on disk. Sections are read in as scans need them
+ * 
+ * @param path Path to module
+ * @param out Module
+ * @return altdumper_status Status
+ */
+ALTDUMPER_API altdumper_status altdumper_open_module(const char* path, altdumper_module** out);
+
+/**
+ * @brief Open minidump or raw memory dump, to open modules out of
+ * 
+ * @param path Path to dump
+ * @param out Snapshot
+ * @return altdumper_status Status
+ */
+ALTDUMPER_API altdumper_status altdumper_open_snapshot(const char* path, altdumper_snapshot** out);
+
+/**
+ * @brief Open module out of a snapshot, as the process had it in memory
+ * 
+ * @param snapshot Snapshot, has to outlive the module
+ * @param name Image file name, or path ending in one
+ * @param out Module
+ * @return altdumper_status Status
+ */
+ALTDUMPER_API altdumper_status altdumper_open_snapshot_module(const altdumper_snapshot* snapshot, const char* name, altdumper_module** out);
+
+ALTDUMPER_API void altdumper_close_module(altdumper_module* module);
+ALTDUMPER_API void altdumper_close_snapshot(altdumper_snapshot* snapshot);
+
+/**
+ * @brief Keep module's q-gram indices in folder, so they're read back by
+ * whichever process opens the same module next
+ * 
+ * @param module Module
+ * @param folder Folder, null to keep them in memory only
+ * @return altdumper_status Status
+ */
+ALTDUMPER_API altdumper_status altdumper_set_cache(altdumper_module* module, const char* folder);
+
+ALTDUMPER_API altdumper_status altdumper_get_module_info(const altdumper_module* module, altdumper_module_info* out);
+
+/**
+ * @brief Compile signature, like "55 8B EC ? ? 53"
+ * 
+ * @param signature Signature
+ * @param out Pattern, usable with any module
+ * @return altdumper_status Status
+ */
+ALTDUMPER_API altdumper_status altdumper_compile_pattern(const char* signature, altdumper_pattern** out);
+
+ALTDUMPER_API void altdumper_free_pattern(altdumper_pattern* pattern);
+
+/**
+ * @brief Resolve entries in one go. They're planned together, so signatures
+ * sharing a section are found in one pass, and so are strings when that's
+ * cheaper. Matches are kept by the module, so resolving more entries of it
+ * later picks up where these left off
+ * 
+ * @param module Module
+ * @param entries Entries, each getting its status and relative address
+ * @param count Entries
+ * @return altdumper_status ALTDUMPER_OK when every entry resolved, otherwise
+ * the first failing entry's status
+ */
+ALTDUMPER_API altdumper_status altdumper_resolve(altdumper_module* module, altdumper_entry* entries, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+// ===========================================
@@ -0,0 +1,284 @@
+/**
+ * @file api.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief C interface to the scanning engine
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "altdumper.h"
+#include <new>
+#include <string>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include "../ctx/ctx.hh"
+#include "../pattern/pattern.hh"
+#include "../plan/plan.hh"
+#include "../rtti/rtti.hh"
+#include "../snapshot/snapshot.hh"
+// ===========================================
+
+// ===========================================
+struct altdumper_snapshot {
+    snapshot::context captured;
+};
+
+struct altdumper_module {
+    std::unique_ptr<modules::context> module = nullptr;
+
+    // built by the first vtable entry, every other one is a lookup
+    std::optional<rtti::context> types = std::nullopt;
+};
+
+struct altdumper_pattern {
+    pattern::context compiled;
+};
+
+namespace api {
+namespace detail {
+// scanned by kind when an entry doesn't say, as in configs
+constexpr const char* sections[] = {".text", ".text", "", ".text", ".rdata"};
+
+inline auto& last_error() {
+    thread_local std::string message = {};
+    return message;
+}
+
+inline auto fail(altdumper_status status, const char* message) {
+    last_error() = message;
+    return status;
+}
+
+/**
+ * Run call, turning whatever it throws into a status
+ */
+template<typename F>
+inline altdumper_status guard(F&& call) {
+    try {
+        return call();
+    } catch (const std::bad_alloc&) {
+        return fail(ALTDUMPER_FAILED, "Out of memory.");
+    } catch (const std::invalid_argument& error) {
+        return fail(ALTDUMPER_INVALID_ARGUMENT, error.what());
+    } catch (const std::exception& error) {
+        return fail(ALTDUMPER_FAILED, error.what());
+    } catch (...) {
+        return fail(ALTDUMPER_FAILED, "Unknown error.");
+    }
+}
+
+/**
+ * Resolve entry, its passes having run already
+ */
+inline std::optional<ptr> resolve(altdumper_module& handle, const altdumper_entry& entry, std::string_view section) {
+    const auto& module = *handle.module;
+
+    switch (entry.kind) {
+        case ALTDUMPER_SIGNATURE: {
+            const auto found = module.find_signature(entry.pattern->compiled, section, entry.nth);
+            return found.has_value() ? std::optional {module.dereferenced(found.value().padded(entry.padding), entry.dereferences)} : std::nullopt;
+        }
+        case ALTDUMPER_STRING_SEARCH: {
+            const auto found = module.find_string(entry.name, section, entry.nth);
+            return found.has_value() ? std::optional {module.dereferenced(found.value().padded(entry.padding), entry.dereferences)} : std::nullopt;
+        }
+        case ALTDUMPER_PROCEDURE: {
+            return module.find_procedure(entry.name);
+        }
+        case ALTDUMPER_CONVAR: {
+            return module.find_convar(entry.name, entry.server_bounded);
+        }
+        case ALTDUMPER_VTABLE: {
+            if (!handle.types.has_value()) {
+                handle.types.emplace(module);
+            }
+
+            return handle.types->find_vtable(entry.name, (uint32_t)entry.nth);
+        }
+    }
+
+    throw std::invalid_argument("Unknown entry kind.");
+}
+}  // namespace detail
+}  // namespace api
+
+extern "C" {
+uint32_t altdumper_version(void) {
+    return ALTDUMPER_API_VERSION;
+}
+
+const char* altdumper_last_error(void) {
+    return api::detail::last_error().c_str();
+}
+
+altdumper_status altdumper_open_module(const char* path, altdumper_module** out) {
+    if (!path || !out) {
+        return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Null argument.");
+    }
+
+    return api::detail::guard([&]() {
+        auto handle    = std::make_unique<altdumper_module>();
+        handle->module = std::make_unique<modules::context>(std::string {path});
+
+        *out = handle.release();
+        return ALTDUMPER_OK;
+    });
+}
+
+altdumper_status altdumper_open_snapshot(const char* path, altdumper_snapshot** out) {
+    if (!path || !out) {
+        return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Null argument.");
+    }
+
+    return api::detail::guard([&]() {
+        *out = new altdumper_snapshot {snapshot::context(std::string {path})};
+        return ALTDUMPER_OK;
+    });
+}
+
+altdumper_status altdumper_open_snapshot_module(const altdumper_snapshot* snapshot, const char* name, altdumper_module** out) {
+    if (!snapshot || !name || !out) {
+        return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Null argument.");
+    }
+
+    return api::detail::guard([&]() {
+        auto handle    = std::make_unique<altdumper_module>();
+        handle->module = std::make_unique<modules::context>(snapshot->captured, name);
+
+        *out = handle.release();
+        return ALTDUMPER_OK;
+    });
+}
+
+void altdumper_close_module(altdumper_module* module) {
+    delete module;
+}
+
+void altdumper_close_snapshot(altdumper_snapshot* snapshot) {
+    delete snapshot;
+}
+
+altdumper_status altdumper_set_cache(altdumper_module* module, const char* folder) {
+    if (!module) {
+        return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Null argument.");
+    }
+
+    return api::detail::guard([&]() {
+        module->module->set_filter_cache(folder ? std::filesystem::path {folder} : std::filesystem::path {});
+        return ALTDUMPER_OK;
+    });
+}
+
+altdumper_status altdumper_get_module_info(const altdumper_module* module, altdumper_module_info* out) {
+    if (!module || !out) {
+        return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Null argument.");
+    }
+
+    const auto& value = *module->module;
+
+    out->image_base = value.get_image_base();
+    out->size       = (uint32_t)value.get_size();
+    out->x64        = value.get_architecture() == modules::context::architecture::x64;
+    return ALTDUMPER_OK;
+}
+
+altdumper_status altdumper_compile_pattern(const char* signature, altdumper_pattern** out) {
+    if (!signature || !out) {
+        return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Null argument.");
+    }
+
+    return api::detail::guard([&]() {
+        // a signature that doesn't parse is the caller's to fix
+        std::unique_ptr<altdumper_pattern> handle = nullptr;
+        try {
+            handle.reset(new altdumper_pattern {pattern::context(signature)});
+        } catch (const std::runtime_error& error) {
+            return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, error.what());
+        }
+
+        if (!handle->compiled.get_size()) {
+            return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Empty signature.");
+        }
+
+        *out = handle.release();
+        return ALTDUMPER_OK;
+    });
+}
+
+void altdumper_free_pattern(altdumper_pattern* pattern) {
+    delete pattern;
+}
+
+altdumper_status altdumper_resolve(altdumper_module* module, altdumper_entry* entries, size_t count) {
+    if (!module || (count && !entries)) {
+        return api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Null argument.");
+    }
+
+    return api::detail::guard([&]() {
+        const auto& value = *module->module;
+
+        // planned as a config's entries are, only with nothing timed before
+        std::vector<plan::entry> planned = {};
+        for (size_t i = 0; i < count; ++i) {
+            auto& entry  = entries[i];
+            entry.status = ALTDUMPER_OK;
+            entry.rva    = 0;
+
+            if (((unsigned)entry.kind > ALTDUMPER_VTABLE) || ((entry.kind == ALTDUMPER_SIGNATURE) ? !entry.pattern : !entry.name)) {
+                entry.status = api::detail::fail(ALTDUMPER_INVALID_ARGUMENT, "Entry is missing its pattern or name.");
+                continue;
+            }
+
+            // kinds are numbered as the planner's
+            plan::entry step = {(plan::kind)entry.kind, i};
+            step.name        = entry.name ? entry.name : "";
+            step.section     = entry.section ? entry.section : api::detail::sections[entry.kind];
+            step.nth_match   = entry.nth;
+
+            if (entry.kind == ALTDUMPER_SIGNATURE) {
+                step.pattern = &entry.pattern->compiled;
+            } else if ((entry.kind == ALTDUMPER_STRING_SEARCH) || (entry.kind == ALTDUMPER_CONVAR)) {
+                step.string = step.name;
+            }
+
+            planned.push_back(step);
+        }
+
+        // nothing keeps timings here, so what passes took isn't handed out
+        const plan::history past = {};
+        const plan::context order(value, std::move(planned), past);
+        (void)order.run(value);
+
+        for (const auto& step : order.get_entries()) {
+            auto& entry = entries[step.index];
+
+            const auto status = api::detail::guard([&]() {
+                const auto found = api::detail::resolve(*module, entry, step.section);
+                if (!found.has_value()) {
+                    return api::detail::fail(ALTDUMPER_NOT_FOUND, "Not found.");
+                }
+
+                entry.rva = (uint32_t)(found.value().get() - (uintptr_t)value.get_bytes());
+                return ALTDUMPER_OK;
+            });
+
+            entry.status = status;
+        }
+
+        // first failing entry, in the caller's order
+        for (size_t i = 0; i < count; ++i) {
+            if (entries[i].status != ALTDUMPER_OK) {
+                return entries[i].status;
+            }
+        }
+
+        return ALTDUMPER_OK;
+    });
+}
+}
+// ===========================================
@@ -17,23 +17,101 @@
 #include <variant>
 #include <array>
 #include <fstream>
+#include <sstream>
 #include <filesystem>
 #include <map>
 #include <limits>
+#include <memory>
+#include <set>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <memory_resource>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <tuple>
+#include <cstdlib>
+#include <cctype>
+#include <ctime>
+#include <iomanip>
 #include <Windows.h>
 #include <ShlObj.h>
 // ===========================================
 #include "ctx/ctx.hh"
+#include "sched/sched.hh"
+#include "io/io.hh"
+#include "snapshot/snapshot.hh"
+#include "plan/plan.hh"
+#include "pattern/pattern.hh"
+#include "rtti/rtti.hh"
+#include "netvars/netvars.hh"
+#include "interfaces/interfaces.hh"
+#include "metrics/metrics.hh"
+#include "cancel/cancel.hh"
+#include "fleet/fleet.hh"
 #include "code_gen/code_gen.hh"
 #include "vendor/json/json.hh"
 // ===========================================
 
+// ===========================================
+#ifdef ALTDUMPER_COUNT_ALLOCATIONS
+// every heap allocation in the process is counted, make() reports
+// how many resolving entries took
+namespace utility {
+namespace allocations {
+    inline std::atomic<size_t> count = 0;
+}  // namespace allocations
+}  // namespace utility
+
+void* operator new(size_t size) {
+    ++utility::allocations::count;
+    if (auto block = std::malloc(size ? size : 1)) {
+        return block;
+    }
+
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    std::free(block);
+}
+#endif
+// ===========================================
+
 // ===========================================
 namespace indices {
 enum {
     exit,
     write,
-    make
+    make,
+    verify,
+    strings,
+    watch,
+    shard
+};
+}
+
+// set from the command line
+namespace arguments {
+// print each module's plan before it's carried out
+bool explain = false;
+
+// process snapshot modules are read out of, rather than their files
+std::optional<snapshot::context> captured = std::nullopt;
+
+// the above as given, handed down to worker processes
+std::string forwarded = {};
+}  // namespace arguments
+
+namespace results {
+enum {
+    // distinct from EXIT_FAILURE, which main takes for an unsupported option
+    mismatched = 2
 };
 }
 // ===========================================
@@ -55,24 +133,29 @@ namespace json {
          * @param nth_match
          * @param padding 
          * @param dereferences 
+         * @param mismatches Bytes the nearest match may get wrong, if there's no exact one
          */
-        [[nodiscard]] signature(std::string&& signature, size_t nth_match, int padding, int dereferences) {
-            _signature    = std::move(signature);
+        [[nodiscard]] signature(std::string_view signature, size_t nth_match, int padding, int dereferences, size_t mismatches)
+            : _signature(signature) {
             _nth_match    = nth_match;
             _padding      = padding;
             _dereferences = dereferences;
+            _mismatches   = mismatches;
         }
 
         /**
          * @brief Construct a new signature object from JSON
          * 
-         * @param json Entry
+         * @param json Entry, has to outlive the object as its strings are viewed in place
          */
-        [[nodiscard]] signature(const nlohmann::json& json) {
-            _signature    = std::move(json["signature"].get<std::string>());
+        [[nodiscard]] explicit signature(const nlohmann::json& json)
+            : _signature(json["signature"].get_ref<const std::string&>()) {
             _nth_match    = json["nth-match"].get<size_t>();
             _padding      = json["padding"].get<int>();
             _dereferences = json["dereferences"].get<int>();
+
+            // older configs don't have it, they only want exact matches
+            _mismatches = json.value("mismatches", (size_t)0);
         }
 
       private:
@@ -80,17 +163,18 @@ namespace json {
         // DATA
         //
 
-        std::string _signature = {};
-        size_t _nth_match      = 0;
-        int _padding           = 0;
-        int _dereferences      = 0;
+        std::string_view _signature = {};
+        size_t _nth_match           = 0;
+        int _padding                = 0;
+        int _dereferences           = 0;
+        size_t _mismatches          = 0;
 
       public:
         //
         // UTILITY
         //
 
-        [[nodiscard]] inline auto get_signature() const {
+        inline auto get_signature() const {
             return _signature;
         }
 
@@ -106,6 +190,10 @@ namespace json {
             return _dereferences;
         }
 
+        inline auto get_mismatches() const {
+            return _mismatches;
+        }
+
         //
         // EXPORT
         //
@@ -117,6 +205,7 @@ namespace json {
             json["nth-match"]    = object.get_nth_match();
             json["padding"]      = object.get_padding();
             json["dereferences"] = object.get_dereferences();
+            json["mismatches"]   = object.get_mismatches();
 
             return json;
         }
@@ -139,9 +228,9 @@ namespace json {
          * @param padding 
          * @param dereferences 
          */
-        [[nodiscard]] string_search(std::string&& string, std::string&& section, size_t reference_instance, int padding, int dereferences) {
-            _string             = std::move(string);
-            _section            = std::move(section);
+        [[nodiscard]] string_search(std::string_view string, std::string_view section, size_t reference_instance, int padding, int dereferences)
+            : _string(string)
+            , _section(section) {
             _reference_instance = reference_instance;
             _padding            = padding;
             _dereferences       = dereferences;
@@ -150,11 +239,11 @@ namespace json {
         /**
          * @brief Construct a new string search object from JSON
          * 
-         * @param json Entry
+         * @param json Entry, has to outlive the object as its strings are viewed in place
          */
-        [[nodiscard]] string_search(const nlohmann::json& json) {
-            _string             = std::move(json["string"].get<std::string>());
-            _section            = std::move(json["section"].get<std::string>());
+        [[nodiscard]] explicit string_search(const nlohmann::json& json)
+            : _string(json["string"].get_ref<const std::string&>())
+            , _section(json["section"].get_ref<const std::string&>()) {
             _reference_instance = json["reference-instance"].get<size_t>();
             _padding            = json["padding"].get<int>();
             _dereferences       = json["dereferences"].get<int>();
@@ -165,8 +254,8 @@ namespace json {
         // DATA
         //
 
-        std::string _string        = {};
-        std::string _section       = {};
+        std::string_view _string   = {};
+        std::string_view _section  = {};
         size_t _reference_instance = 0;
         int _padding               = 0;
         int _dereferences          = 0;
@@ -176,11 +265,11 @@ namespace json {
         // UTILITY
         //
 
-        [[nodiscard]] inline auto get_string() const {
+        inline auto get_string() const {
             return _string;
         }
 
-        [[nodiscard]] inline auto get_section() const {
+        inline auto get_section() const {
             return _section;
         }
 
@@ -226,18 +315,18 @@ namespace json {
          * @param name ConVar name
          * @param server_bounded Server Bounded constructor?
          */
-        [[nodiscard]] convar(std::string&& name, bool server_bounded) {
-            _name           = std::move(name);
+        [[nodiscard]] convar(std::string_view name, bool server_bounded)
+            : _name(name) {
             _server_bounded = server_bounded;
         }
 
         /**
          * @brief Construct a new convar object from JSON
          * 
-         * @param json Entry
+         * @param json Entry, has to outlive the object as its strings are viewed in place
          */
-        [[nodiscard]] convar(const nlohmann::json& json) {
-            _name           = std::move(json["name"].get<std::string>());
+        [[nodiscard]] explicit convar(const nlohmann::json& json)
+            : _name(json["name"].get_ref<const std::string&>()) {
             _server_bounded = json["server-bounded"].get<int>();
         }
 
@@ -246,7 +335,7 @@ namespace json {
         // DATA
         //
 
-        std::string _name;
+        std::string_view _name = {};
         bool _server_bounded;
 
       public:
@@ -254,7 +343,7 @@ namespace json {
         // UTILITY
         //
 
-        [[nodiscard]] inline auto get_name() const {
+        inline auto get_name() const {
             return _name;
         }
 
@@ -288,32 +377,30 @@ namespace json {
          * 
          * @param name 
          */
-        [[nodiscard]] procedure(std::string&& name) {
-            _name = std::move(name);
-        }
+        [[nodiscard]] procedure(std::string_view name)
+            : _name(name) {}
 
         /**
          * @brief Construct a new procedure object from JSON
          * 
-         * @param json Entry
+         * @param json Entry, has to outlive the object as its strings are viewed in place
          */
-        [[nodiscard]] procedure(const nlohmann::json& json) {
-            _name = std::move(json["name"].get<std::string>());
-        }
+        [[nodiscard]] explicit procedure(const nlohmann::json& json)
+            : _name(json["name"].get_ref<const std::string&>()) {}
 
       private:
         //
         // DATA
         //
 
-        std::string _name;
+        std::string_view _name = {};
 
       public:
         //
         // UTILITY
         //
 
-        [[nodiscard]] inline auto get_name() const {
+        inline auto get_name() const {
             return _name;
         }
 
@@ -329,7 +416,285 @@ namespace json {
             return json;
         }
     };
+
+    struct vtable {
+        //
+        // CONSTRUCTORS
+        //
+
+        vtable() = default;
+
+        /**
+         * @brief Construct a new vtable object from data
+         * 
+         * @param name Decorated (".?AVName@@") or plain class name
+         * @param offset Subobject offset, 0 for the complete object's vtable
+         */
+        [[nodiscard]] vtable(std::string_view name, uint32_t offset)
+            : _name(name) {
+            _offset = offset;
+        }
+
+        /**
+         * @brief Construct a new vtable object from JSON
+         * 
+         * @param json Entry, has to outlive the object as its strings are viewed in place
+         */
+        [[nodiscard]] explicit vtable(const nlohmann::json& json)
+            : _name(json["name"].get_ref<const std::string&>()) {
+            _offset = json["offset"].get<uint32_t>();
+        }
+
+      private:
+        //
+        // DATA
+        //
+
+        std::string_view _name = {};
+        uint32_t _offset = 0;
+
+      public:
+        //
+        // UTILITY
+        //
+
+        inline auto get_name() const {
+            return _name;
+        }
+
+        inline auto get_offset() const {
+            return _offset;
+        }
+
+        //
+        // EXPORT
+        //
+
+        [[nodiscard]] static nlohmann::json to_json(vtable&& object) {
+            nlohmann::json json;
+
+            json["name"]   = object.get_name();
+            json["offset"] = object.get_offset();
+
+            return json;
+        }
+    };
+
+    struct netvar {
+        //
+        // CONSTRUCTORS
+        //
+
+        netvar() = default;
+
+        /**
+         * @brief Construct a new netvar object from data
+         * 
+         * @param table RecvTable name, like DT_BasePlayer
+         */
+        [[nodiscard]] netvar(std::string_view table)
+            : _table(table) {}
+
+        /**
+         * @brief Construct a new netvar object from JSON
+         * 
+         * @param json Entry, has to outlive the object as its strings are viewed in place
+         */
+        [[nodiscard]] explicit netvar(const nlohmann::json& json)
+            : _table(json["table"].get_ref<const std::string&>()) {}
+
+      private:
+        //
+        // DATA
+        //
+
+        std::string_view _table = {};
+
+      public:
+        //
+        // UTILITY
+        //
+
+        inline auto get_table() const {
+            return _table;
+        }
+
+        //
+        // EXPORT
+        //
+
+        [[nodiscard]] static nlohmann::json to_json(netvar&& object) {
+            nlohmann::json json;
+
+            json["table"] = object.get_table();
+
+            return json;
+        }
+    };
+
+    struct registration {
+        //
+        // CONSTRUCTORS
+        //
+
+        registration() = default;
+
+        /**
+         * @brief Construct a new registration object from data
+         * 
+         * @param name Version string, or the name without its version digits
+         * @param instance Instance address rather than the factory's?
+         */
+        [[nodiscard]] registration(std::string_view name, bool instance)
+            : _name(name) {
+            _instance = instance;
+        }
+
+        /**
+         * @brief Construct a new registration object from JSON
+         * 
+         * @param json Entry, has to outlive the object as its strings are viewed in place
+         */
+        [[nodiscard]] explicit registration(const nlohmann::json& json)
+            : _name(json["name"].get_ref<const std::string&>()) {
+            _instance = json["instance"].get<bool>();
+        }
+
+      private:
+        //
+        // DATA
+        //
+
+        std::string_view _name = {};
+        bool _instance = false;
+
+      public:
+        //
+        // UTILITY
+        //
+
+        inline auto get_name() const {
+            return _name;
+        }
+
+        inline auto get_instance() const {
+            return _instance;
+        }
+
+        //
+        // EXPORT
+        //
+
+        [[nodiscard]] static nlohmann::json to_json(registration&& object) {
+            nlohmann::json json;
+
+            json["name"]     = object.get_name();
+            json["instance"] = object.get_instance();
+
+            return json;
+        }
+    };
+
+    /**
+     * @brief Identifies an entry by type and contents, not by name
+     * 
+     */
+    struct entry_key {
+        //
+        // DATA
+        //
+
+        std::string_view type       = {};
+        const nlohmann::json* entry = nullptr;
+
+        //
+        // OPERATORS
+        //
+
+        inline auto operator==(const entry_key& other) const {
+            return (type == other.type) && (*entry == *other.entry);
+        }
+    };
+
+    struct entry_hash {
+        inline auto operator()(const entry_key& key) const {
+            return std::hash<std::string_view> {}(key.type) ^ std::hash<nlohmann::json> {}(*key.entry);
+        }
+    };
+
+    // stands in for entry types configs from before them don't have
+    inline const nlohmann::json none = nlohmann::json::object();
+
+    // resolved address per entry
+    using memo = std::pmr::unordered_map<entry_key, uintptr_t, entry_hash>;
+
+    /**
+     * @brief Get every section a module's entries scan through
+     * 
+     * @param json Module entry
+     * @return std::set<std::string> Section names
+     */
+    [[nodiscard]] inline auto get_referenced_sections(const nlohmann::json& json) {
+        std::set<std::string> sections = {};
+
+        if (json.contains("signatures") && !json["signatures"].empty()) {
+            sections.insert(".text");
+        }
+
+        if (json.contains("string-search")) {
+            for (const auto& [key, value] : json["string-search"].items()) {
+                sections.insert(".rdata");
+                sections.insert(value["section"].get<std::string>());
+            }
+        }
+
+        if (json.contains("convars") && !json["convars"].empty()) {
+            sections.insert(".rdata");
+            sections.insert(".text");
+        }
+
+        if (json.contains("vtables") && !json["vtables"].empty()) {
+            sections.insert(".data");
+            sections.insert(".rdata");
+        }
+
+        if (json.contains("netvars") && !json["netvars"].empty()) {
+            sections.insert(".data");
+            sections.insert(".rdata");
+        }
+
+        // CreateInterface's code only, the rest is read as it's walked
+        if (json.contains("interfaces") && !json["interfaces"].empty()) {
+            sections.insert(".data");
+        }
+
+        // procedures only touch the export directory, paged in on its own
+
+        return sections;
+    }
 }  // namespace json
+namespace code {
+    /**
+     * @brief Make name usable as a C++ identifier
+     * 
+     * @param name Name, as the image has it
+     * @return std::string Identifier, every other character replaced with '_'
+     */
+    [[nodiscard]] inline auto to_identifier(std::string_view name) {
+        std::string out(name);
+        for (auto& c : out) {
+            if (!std::isalnum((unsigned char)c) && c != '_') {
+                c = '_';
+            }
+        }
+
+        if (!out.empty() && std::isdigit((unsigned char)out.front())) {
+            out.insert(out.begin(), '_');
+        }
+
+        return out;
+    }
+}  // namespace code
 namespace winapi {
     [[nodiscard]] auto get_file_from_prompt() {
         char file[MAX_PATH] = {};
@@ -376,6 +741,32 @@ namespace winapi {
 
         return std::string {};
     }
+
+    /**
+     * @brief Have Ctrl+C and Ctrl+Break stop scope, rather than the process
+     * 
+     * @param scope Scope, nullptr to hand them back
+     */
+    inline auto set_interrupt(cancel::context* scope) {
+        static cancel::context* interrupted = nullptr;
+
+        constexpr PHANDLER_ROUTINE handler = [](DWORD type) -> BOOL {
+            if (((type != CTRL_C_EVENT) && (type != CTRL_BREAK_EVENT)) || !interrupted) {
+                return FALSE;
+            }
+
+            interrupted->request();
+            return TRUE;
+        };
+
+        if (scope) {
+            interrupted = scope;
+            SetConsoleCtrlHandler(handler, TRUE);
+        } else {
+            SetConsoleCtrlHandler(handler, FALSE);
+            interrupted = nullptr;
+        }
+    }
 }  // namespace winapi
 }  // namespace utility
 // ===========================================
@@ -431,7 +822,18 @@ namespace handlers {
             goto dereferences_label;
         }
 
-        section[entry] = utility::json::signature::to_json({std::move(signature), nth_match, padding, dereferences});
+    mismatches_label:
+        std::cout << "Mismatches allowed when there's no exact match (0 to require one):\n";
+        size_t mismatches = 0;
+        std::cin >> mismatches;
+
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<int>::max(), '\n');
+            goto mismatches_label;
+        }
+
+        section[entry] = utility::json::signature::to_json({signature, nth_match, padding, dereferences, mismatches});
     }
 
     auto add_string_search(nlohmann::json& section) {
@@ -480,7 +882,7 @@ namespace handlers {
             goto dereferences_label;
         }
 
-        section[entry] = utility::json::string_search::to_json({std::move(string), std::move(scan_section), reference_instance, padding, dereferences});
+        section[entry] = utility::json::string_search::to_json({string, scan_section, reference_instance, padding, dereferences});
     }
 
     auto add_procedure(nlohmann::json& section) {
@@ -492,7 +894,7 @@ namespace handlers {
         std::string name = {};
         std::getline(std::cin >> std::ws, name);
 
-        section[entry] = utility::json::procedure::to_json({std::move(name)});
+        section[entry] = utility::json::procedure::to_json({std::string_view {name}});
     }
 
     auto add_convar(nlohmann::json& section) {
@@ -515,7 +917,65 @@ namespace handlers {
             goto server_bounded_label;
         }
 
-        section[entry] = utility::json::convar::to_json({std::move(name), server_bounded});
+        section[entry] = utility::json::convar::to_json({name, server_bounded});
+    }
+
+    auto add_vtable(nlohmann::json& section) {
+        std::cout << "Entry:\n";
+        std::string entry = {};
+        std::getline(std::cin >> std::ws, entry);
+
+        std::cout << "Class name (plain, or decorated as .?AVName@@):\n";
+        std::string name = {};
+        std::getline(std::cin >> std::ws, name);
+
+    offset_label:
+        std::cout << "Subobject offset (0 for the complete object's vtable):\n";
+        uint32_t offset = 0;
+        std::cin >> offset;
+
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<int>::max(), '\n');
+            goto offset_label;
+        }
+
+        section[entry] = utility::json::vtable::to_json({std::string_view {name}, offset});
+    }
+
+    auto add_interface(nlohmann::json& section) {
+        std::cout << "Entry:\n";
+        std::string entry = {};
+        std::getline(std::cin >> std::ws, entry);
+
+        std::cout << "Version string (like VEngineClient014, or VEngineClient for whichever version is there):\n";
+        std::string name = {};
+        std::getline(std::cin >> std::ws, name);
+
+    instance_label:
+        std::cout << "Instance (1 for the instance the factory returns, 0 for the factory):\n";
+        bool instance = false;
+        std::cin >> instance;
+
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<int>::max(), '\n');
+            goto instance_label;
+        }
+
+        section[entry] = utility::json::registration::to_json({std::string_view {name}, instance});
+    }
+
+    auto add_netvar(nlohmann::json& section) {
+        std::cout << "Entry (becomes the namespace its props are written to):\n";
+        std::string entry = {};
+        std::getline(std::cin >> std::ws, entry);
+
+        std::cout << "Table (like DT_BasePlayer):\n";
+        std::string table = {};
+        std::getline(std::cin >> std::ws, table);
+
+        section[entry] = utility::json::netvar::to_json({std::string_view {table}});
     }
 }  // namespace handlers
 [[nodiscard]] int exit() {
@@ -587,18 +1047,23 @@ here:
         auto& string_search = node["string-search"];
         auto& procedures    = node["procedures"];
         auto& convars       = node["convars"];
+        auto& vtables       = node["vtables"];
+        auto& netvars       = node["netvars"];
+        auto& registrations = node["interfaces"];
 
     restart:
-        // TODO: add netvars to misc scanner
         enum push_levels {
             go_back = 1,
             add_signature,
             add_string_search,
             add_procedure,
-            add_convar
+            add_convar,
+            add_vtable,
+            add_netvar,
+            add_interface
         };
 
-        std::cout << "Pushing to \"" << name << "\".\nTo go back to module prompting, input \"" << push_levels::go_back << "\". To import a signature, input \"" << push_levels::add_signature << "\". To import a string search, input \"" << push_levels::add_string_search << "\". To import a procedure, input \"" << push_levels::add_procedure << "\".\nThe following are also available (tested for CS:GO only): To input a ConVar, input \"" << push_levels::add_convar << "\".\n";
+        std::cout << "Pushing to \"" << name << "\".\nTo go back to module prompting, input \"" << push_levels::go_back << "\". To import a signature, input \"" << push_levels::add_signature << "\". To import a string search, input \"" << push_levels::add_string_search << "\". To import a procedure, input \"" << push_levels::add_procedure << "\".\nThe following are also available (tested for CS:GO only): To input a ConVar, input \"" << push_levels::add_convar << "\". To import a vtable by RTTI class name, input \"" << push_levels::add_vtable << "\". To import a netvar table, input \"" << push_levels::add_netvar << "\". To import an interface from the CreateInterface registry, input \"" << push_levels::add_interface << "\".\n";
 
         int indice = -1;
         std::cin >> indice;
@@ -620,6 +1085,15 @@ here:
             case push_levels::add_convar: {
                 handlers::add_convar(convars);
             } break;
+            case push_levels::add_vtable: {
+                handlers::add_vtable(vtables);
+            } break;
+            case push_levels::add_netvar: {
+                handlers::add_netvar(netvars);
+            } break;
+            case push_levels::add_interface: {
+                handlers::add_interface(registrations);
+            } break;
         }
 
         goto restart;
@@ -628,194 +1102,1775 @@ here:
     return EXIT_SUCCESS;
 }
 
-[[nodiscard]] int make() {
-    std::cout << "Provide config file:\n";
-    auto&& config_name = utility::winapi::get_file_from_prompt();
+namespace dump {
+    struct options {
+        //
+        // DATA
+        //
 
-    // open stream
-    std::ifstream file(config_name);
+        // MiB, 0 for unlimited
+        size_t budget = 0;
+        size_t window = 0;
 
-    // parse stream as json
-    const nlohmann::json& config = nlohmann::json::parse(file);
+        // seconds and MiB scanned, 0 for none
+        double entry_time   = 0;
+        size_t entry_bytes  = 0;
+        double module_time  = 0;
+        size_t module_bytes = 0;
+    };
 
-    // make file editable/free again, as contents've been copied
-    file.close();
+    struct results {
+        //
+        // DATA
+        //
 
-    // final data container
-    std::map<std::string, std::map<std::string, uintptr_t>> addresses = {};
+        // per module, by entry
+        std::map<std::string, std::map<std::string, uintptr_t>> addresses = {};
 
-    std::vector<std::thread> thread_pool = {};
+        // netvar tables, per module then entry, by prop
+        std::map<std::string, std::map<std::string, std::map<std::string, uintptr_t>>> tables = {};
 
-    // multi-threaded process
-    for (const auto& [key, value] : config.items()) {
-        // this is done here to order DLL entries by JSON order,
-        // not by which thread runs first
-        auto& map_entry_key = addresses[key];
-
-        // couldn't uniformly initialize a std::function, for some reason, didn't give it
-        // much thought either. shouldn't be too bad, anyhow/anywho
-        const std::function<void()>& work = [&]() {
-            modules::context dll(key);
-
-            const auto& signatures    = value["signatures"];
-            const auto& string_search = value["string-search"];
-            const auto& procedures    = value["procedures"];
-            const auto& convars       = value["convars"];
-
-            for (const auto& [key, value] : signatures.items()) {
-                const auto& data = utility::json::signature(value);
-
-                // credits for this runtime solution: https://github.com/spirthack/CSGOSimple
-                // TODO: look into making this better
-                // offtopic: for an alternative, compile-time solution, refer to:
-                // https://github.com/cristeigabriel/STB
-                static auto pattern_to_bytes = [](std::string&& pattern) {
-                    auto bytes = std::vector<int> {};
-                    auto start = pattern.data();
-                    auto end   = pattern.data() + pattern.size();
-
-                    for (auto current = start; current < end; ++current) {
-                        if (*current == '?') {
-                            ++current;
-                            if (*current == '?')
-                                ++current;
-                            bytes.push_back(-1);
+        // entries which didn't resolve, per module, by why
+        std::map<std::string, std::map<std::string, std::string>> failures = {};
+    };
+
+    /**
+     * @brief Prompt for the limits a dump runs under
+     * 
+     * @return options Limits
+     */
+    [[nodiscard]] options prompt_options() {
+        options out = {};
+
+    budget_label:
+        std::cout << "Memory budget for mapped modules, in MiB (0 for unlimited):\n";
+        std::cin >> out.budget;
+
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<int>::max(), '\n');
+            goto budget_label;
+        }
+
+    window_label:
+        std::cout << "Streaming window for scanning sections bigger than it, in MiB (0 to read whole sections in):\n";
+        std::cin >> out.window;
+
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<int>::max(), '\n');
+            goto window_label;
+        }
+
+    entry_limits_label:
+        std::cout << "Limits per entry, in seconds then MiB scanned, like \"5 256\" (0 for none):\n";
+        std::cin >> out.entry_time >> out.entry_bytes;
+
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<int>::max(), '\n');
+            goto entry_limits_label;
+        }
+
+    module_limits_label:
+        std::cout << "Limits per module, in seconds then MiB scanned (0 for none):\n";
+        std::cin >> out.module_time >> out.module_bytes;
+
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<int>::max(), '\n');
+            goto module_limits_label;
+        }
+
+        return out;
+    }
+
+    /**
+     * @brief Open module, out of the snapshot given on the command line if there's one
+     * 
+     * @param key Path to module, only its file name counts in a snapshot
+     * @return std::unique_ptr<modules::context> Module
+     */
+    [[nodiscard]] std::unique_ptr<modules::context> open_module(const std::string& key) {
+        if (arguments::captured.has_value()) {
+            return std::make_unique<modules::context>(arguments::captured.value(), key);
+        }
+
+        return std::make_unique<modules::context>(key);
+    }
+
+    /**
+     * @brief Resolve every entry of every module in config
+     * 
+     * @param config Config, or the part of one to resolve
+     * @param limits Limits
+     * @param run Scope every module's and entry's scope is nested in
+     * @return results Results, every module in config having its maps
+     */
+    [[nodiscard]] results resolve(const nlohmann::json& config, const options& limits, cancel::context& run) {
+        results out = {};
+
+        // final data container
+        auto& addresses = out.addresses;
+
+        // entries which didn't resolve, per module, by why
+        auto& failures                                                   = out.failures;
+        std::vector<std::map<std::string, std::string>*> failure_outputs = {};
+
+        // per module, in JSON order. only headers are read here, sections
+        // get read ahead of whichever worker picks the module up
+        std::vector<std::string> keys                          = {};
+        std::vector<std::map<std::string, uintptr_t>*> outputs = {};
+
+        // netvar tables, per module then entry, by prop
+        auto& tables                                                                        = out.tables;
+        std::vector<std::map<std::string, std::map<std::string, uintptr_t>>*> table_outputs = {};
+
+        // per distinct image, byte-identical modules are loaded and scanned once,
+        // their group lists every module index which shares it
+        std::vector<std::unique_ptr<modules::context>> contexts = {};
+        std::vector<std::vector<size_t>> groups                 = {};
+        std::unordered_map<uint64_t, size_t> images             = {};
+
+        // sections the group's entries look at, per distinct image
+        std::vector<std::set<std::string>> referenced = {};
+
+        sched::context scheduler(limits.budget << 20);
+
+        // q-gram filters outlive the run, so modules which haven't changed
+        // since skip building them, and paging in what nothing matches in
+        std::error_code error = {};
+        auto cache            = std::filesystem::temp_directory_path(error) / "altdumper";
+        if (!error) {
+            std::filesystem::create_directories(cache, error);
+        }
+
+        if (error) {
+            cache.clear();
+        }
+
+        // what entries took in past runs, feeding the plans' costs
+        plan::history past(cache.empty() ? std::filesystem::path {} : (cache / "timings.txt"));
+
+#ifdef ALTDUMPER_COUNT_ALLOCATIONS
+        size_t entries = 0;
+#endif
+
+        for (const auto& [key, value] : config.items()) {
+            // this is done here to order DLL entries by JSON order,
+            // not by which thread runs first
+            outputs.push_back(&addresses[key]);
+            table_outputs.push_back(&tables[key]);
+            failure_outputs.push_back(&failures[key]);
+            keys.push_back(key);
+
+#ifdef ALTDUMPER_COUNT_ALLOCATIONS
+            for (const auto& type : {"signatures", "string-search", "procedures", "convars", "vtables", "netvars", "interfaces"}) {
+                entries += value.contains(type) ? value[type].size() : 0;
+            }
+#endif
+
+            metrics::timer load = {};
+
+            auto dll = open_module(key);
+            dll->set_filter_cache(cache);
+            dll->set_window(limits.window << 20);
+
+            auto [image, inserted] = images.try_emplace(dll->get_hash(), contexts.size());
+            metrics::observe(metrics::id::load_seconds, {}, load.get_elapsed());
+            if (!inserted) {
+                std::cout << "[=] " << key << " is identical to " << keys[groups[image->second].front()] << '\n';
+                groups[image->second].push_back(keys.size() - 1);
+                continue;
+            }
+
+            contexts.push_back(std::move(dll));
+            groups.push_back({keys.size() - 1});
+        }
+
+        for (auto i = 0; i < contexts.size(); ++i) {
+            const auto& dll = contexts[i];
+
+            auto& sections = referenced.emplace_back();
+            for (auto index : groups[i]) {
+                sections.merge(utility::json::get_referenced_sections(config.at(keys[index])));
+            }
+
+            // cost is what the module will hold mapped while it's worked on,
+            // the headers page included
+            size_t cost = 0x1000;
+            for (const auto& name : sections) {
+                cost += dll->get_sections().contains(name) ? dll->get_section(name).size : dll->get_size();
+            }
+
+            // .text is scanned rather than walked, so a streamed one holds two
+            // windows, plus the pages results land on. the nearest match
+            // fallback still reads it whole
+            if (dll->get_window() && sections.contains(".text") && dll->get_sections().contains(".text")) {
+                const auto size = dll->get_section(".text").size;
+                cost -= size - std::min(size, 2 * dll->get_window());
+            }
+
+            scheduler.push(i, cost);
+        }
+
+        // sections are read in big blocks, a few at once, ahead of the workers,
+        // so the disk is kept busy while they scan. at most one module per worker
+        // waits read, on top of which the scheduler's budget bounds what's mapped
+        constexpr size_t readers = 4;
+        constexpr size_t block   = 4 << 20;
+
+        const auto workers = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), keys.size());
+        io::context reader(readers, workers, block);
+
+        // per distinct image, the job it was popped as and the sections read for it
+        std::vector<sched::job> loading(contexts.size());
+        std::vector<std::vector<std::string>> prefetch(contexts.size());
+
+        // takes modules in the scheduler's order and queues their sections to be
+        // read. streamed ones are read a window at a time as they're scanned
+        const auto& load = [&]() {
+            while (auto job = scheduler.pop()) {
+                auto& dll = *contexts[job->index];
+
+                std::vector<io::extent> extents = {};
+
+                // a stopped run has nothing left worth reading. what fails
+                // committing is paged in, failing again, by the worker
+                try {
+                    for (const auto& name : referenced[job->index]) {
+                        if (run.is_stopped() || dll.is_streamed(name)) {
+                            continue;
+                        }
+
+                        const auto committed = dll.commit(name);
+                        extents.insert(extents.end(), committed.begin(), committed.end());
+                        prefetch[job->index].push_back(name);
+                    }
+                } catch (const std::exception&) {
+                    extents.clear();
+                    prefetch[job->index].clear();
+                }
+
+                loading[job->index] = job.value();
+                reader.push(job->index, extents);
+            }
+
+            reader.close();
+        };
+
+        // multi-threaded process
+        const auto& work = [&]() {
+            // per worker scratch for everything that doesn't outlive a module,
+            // given back in one go once the next one starts
+            std::array<std::byte, 0x10000> buffer = {};
+            std::pmr::monotonic_buffer_resource scratch(buffer.data(), buffer.size());
+
+            while (auto read = reader.pop()) {
+                // everything the previous module allocated is gone by now
+                scratch.release();
+
+                const auto& job = loading[read->index];
+                auto& dll       = *contexts[job.index];
+
+                // what didn't read gets paged in again, and
+                // says why, by the first entry looking at it
+                if (!read->failed) {
+                    for (const auto& name : prefetch[job.index]) {
+                        dll.set_resident(name);
+                    }
+                }
+
+                // every entry's scope is nested in the module's
+                cancel::context scope(&run, limits.module_time, limits.module_bytes << 20);
+
+                // a failed entry gets a status in the output instead of an address,
+                // the rest go on regardless. nothing thrown leaves the worker
+                const auto attempt = [&](std::map<std::string, std::string>& failed, const std::string& key, const auto& resolve) {
+                    cancel::context entry(&scope, limits.entry_time, limits.entry_bytes << 20);
+                    dll.set_cancel(&entry);
+
+                    try {
+                        resolve();
+                    } catch (const std::exception& error) {
+                        const auto why = entry.get_reason();
+                        failed[key]    = (why != cancel::reason::none) ? std::string {cancel::describe(why)} : error.what();
+                    }
+
+                    dll.set_cancel(nullptr);
+                };
+
+                // results of identical entries are shared across the group
+                utility::json::memo memo(&scratch);
+
+                // built by the first vtable entry, every other one is a lookup
+                std::optional<rtti::context> types = std::nullopt;
+
+                // same for the netvar graph, walked by the first netvar entry
+                std::optional<netvars::context> graph = std::nullopt;
+
+                // and for the interface registry
+                std::optional<interfaces::context> registry = std::nullopt;
+
+                for (auto index : groups[job.index]) {
+                    auto& map_entry_key = *outputs[index];
+                    auto& table_entries = *table_outputs[index];
+                    auto& failed        = *failure_outputs[index];
+                    const auto& value   = config.at(keys[index]);
+
+                    const auto& signatures    = value["signatures"];
+                    const auto& string_search = value["string-search"];
+                    const auto& procedures    = value["procedures"];
+                    const auto& convars       = value["convars"];
+                    const auto& vtables       = value.contains("vtables") ? value["vtables"] : utility::json::none;
+                    const auto& netvar_tables = value.contains("netvars") ? value["netvars"] : utility::json::none;
+                    const auto& registrations = value.contains("interfaces") ? value["interfaces"] : utility::json::none;
+
+                    const auto resolve_signature = [&](const std::string& key, const nlohmann::json& value, const pattern::context& compiled) {
+                        if (auto found = memo.find({"signatures", &value}); found != memo.end()) {
+                            metrics::add(metrics::id::cache_hits, "memo");
+                            map_entry_key[key] = found->second;
+                            return;
+                        }
+
+                        metrics::add(metrics::id::cache_misses, "memo");
+                        metrics::timer timer = {};
+
+                        const auto& data = utility::json::signature(value);
+
+                        uintptr_t address = 0;
+
+                        auto sig = dll.find_signature(compiled, ".text", data.get_nth_match());
+
+                        // likely a game update touched a byte or two. where the pattern
+                        // comes closest is reported as the entry's failure, rather than
+                        // taken for it, so the header comments the candidates
+                        if (!sig.has_value() && data.get_mismatches()) {
+                            const auto& nearest = dll.find_nearest(compiled, ".text", data.get_mismatches(), 4, &scratch);
+                            if (!nearest.empty()) {
+                                std::stringstream report = {};
+                                report << "No exact match, nearest at";
+                                for (const auto& [at, mismatches] : nearest) {
+                                    report << (&at == &nearest.front().address ? " 0x" : ", 0x") << std::hex << (at.get() - (uintptr_t)dll.get_bytes()) << std::dec << " (" << mismatches << " mismatched byte(s))";
+                                }
+
+                                throw std::runtime_error(report.str() + '.');
+                            }
+                        }
+
+                        if (sig.has_value()) {
+                            address = (dll.dereferenced(sig.value().padded(data.get_padding()), data.get_dereferences()).get() - (uintptr_t)dll.get_bytes());
+                        } else {
+                            // well, we can still continue. but, this is decided by
+                            // the one who handles the errors. rawly, upon catches we
+                            // just
+                            throw std::runtime_error("Failed finding pattern.");
+                        }
+
+                        map_entry_key[key] = address;
+                        memo.emplace(utility::json::entry_key {"signatures", &value}, address);
+                        metrics::observe(metrics::id::entry_seconds, "signatures", timer.get_elapsed());
+                    };
+
+                    const auto resolve_string_search = [&](const std::string& key, const nlohmann::json& value) {
+                        if (auto found = memo.find({"string-search", &value}); found != memo.end()) {
+                            metrics::add(metrics::id::cache_hits, "memo");
+                            map_entry_key[key] = found->second;
+                            return;
+                        }
+
+                        metrics::add(metrics::id::cache_misses, "memo");
+                        metrics::timer timer = {};
+
+                        const auto& data = utility::json::string_search(value);
+
+                        uintptr_t address = 0;
+
+                        const auto& ptr = dll.find_string(data.get_string(), data.get_section(), data.get_reference_instance(), &scratch);
+                        if (ptr.has_value()) {
+                            address = (dll.dereferenced(ptr.value().padded(data.get_padding()), data.get_dereferences()).get() - (uintptr_t)dll.get_bytes());
+                        } else {
+                            throw std::runtime_error("Failed finding string.");
+                        }
+
+                        map_entry_key[key] = address;
+                        memo.emplace(utility::json::entry_key {"string-search", &value}, address);
+                        metrics::observe(metrics::id::entry_seconds, "string-search", timer.get_elapsed());
+                    };
+
+                    const auto resolve_procedure = [&](const std::string& key, const nlohmann::json& value) {
+                        if (auto found = memo.find({"procedures", &value}); found != memo.end()) {
+                            metrics::add(metrics::id::cache_hits, "memo");
+                            map_entry_key[key] = found->second;
+                            return;
+                        }
+
+                        metrics::add(metrics::id::cache_misses, "memo");
+                        metrics::timer timer = {};
+
+                        const auto& data = utility::json::procedure(value);
+
+                        uintptr_t address = 0;
+
+                        const auto& ptr = dll.find_procedure(data.get_name());
+                        if (ptr.has_value()) {
+                            address = (ptr.value().get() - (uintptr_t)dll.get_bytes());
+                        } else {
+                            throw std::runtime_error("Failed finding procedure.");
+                        }
+
+                        map_entry_key[key] = address;
+                        memo.emplace(utility::json::entry_key {"procedures", &value}, address);
+                        metrics::observe(metrics::id::entry_seconds, "procedures", timer.get_elapsed());
+                    };
+
+                    const auto resolve_convar = [&](const std::string& key, const nlohmann::json& value) {
+                        if (auto found = memo.find({"convars", &value}); found != memo.end()) {
+                            metrics::add(metrics::id::cache_hits, "memo");
+                            map_entry_key[key] = found->second;
+                            return;
+                        }
+
+                        metrics::add(metrics::id::cache_misses, "memo");
+                        metrics::timer timer = {};
+
+                        const auto& data = utility::json::convar(value);
+
+                        uintptr_t address = 0;
+
+                        const auto& ptr = dll.find_convar(data.get_name(), data.get_server_bounded(), &scratch);
+                        if (ptr.has_value()) {
+                            address = (ptr.value().get() - (uintptr_t)dll.get_bytes());
                         } else {
-                            bytes.push_back(strtoul(current, &current, 16));
+                            throw std::runtime_error("Failed finding convar.");
                         }
+
+                        map_entry_key[key] = address;
+                        memo.emplace(utility::json::entry_key {"convars", &value}, address);
+                        metrics::observe(metrics::id::entry_seconds, "convars", timer.get_elapsed());
+                    };
+
+                    const auto resolve_vtable = [&](const std::string& key, const nlohmann::json& value) {
+                        if (auto found = memo.find({"vtables", &value}); found != memo.end()) {
+                            metrics::add(metrics::id::cache_hits, "memo");
+                            map_entry_key[key] = found->second;
+                            return;
+                        }
+
+                        metrics::add(metrics::id::cache_misses, "memo");
+                        metrics::timer timer = {};
+
+                        const auto& data = utility::json::vtable(value);
+
+                        if (!types.has_value()) {
+                            types.emplace(dll);
+                        }
+
+                        uintptr_t address = 0;
+
+                        const auto& ptr = types->find_vtable(data.get_name(), data.get_offset());
+                        if (ptr.has_value()) {
+                            address = (ptr.value().get() - (uintptr_t)dll.get_bytes());
+                        } else {
+                            throw std::runtime_error("Failed finding vtable.");
+                        }
+
+                        map_entry_key[key] = address;
+                        memo.emplace(utility::json::entry_key {"vtables", &value}, address);
+                        metrics::observe(metrics::id::entry_seconds, "vtables", timer.get_elapsed());
+                    };
+
+                    const auto resolve_registration = [&](const std::string& key, const nlohmann::json& value) {
+                        if (auto found = memo.find({"interfaces", &value}); found != memo.end()) {
+                            metrics::add(metrics::id::cache_hits, "memo");
+                            map_entry_key[key] = found->second;
+                            return;
+                        }
+
+                        metrics::add(metrics::id::cache_misses, "memo");
+                        metrics::timer timer = {};
+
+                        const auto& data = utility::json::registration(value);
+
+                        if (!registry.has_value()) {
+                            registry.emplace(dll);
+                        }
+
+                        const auto found = registry->find_interface(data.get_name());
+                        if (!found || (data.get_instance() && !found->instance)) {
+                            throw std::runtime_error("Failed finding interface.");
+                        }
+
+                        const uintptr_t address = data.get_instance() ? found->instance : found->factory;
+
+                        map_entry_key[key] = address;
+                        memo.emplace(utility::json::entry_key {"interfaces", &value}, address);
+                        metrics::observe(metrics::id::entry_seconds, "interfaces", timer.get_elapsed());
+                    };
+
+                    const auto resolve_netvar = [&](const std::string& key, const nlohmann::json& value) {
+                        metrics::timer timer = {};
+
+                        const auto& data = utility::json::netvar(value);
+
+                        if (!graph.has_value()) {
+                            graph.emplace(dll);
+                        }
+
+                        // tables a build fills in at startup are empty on disk, those
+                        // are failed rather than generated as an empty namespace
+                        if (graph->get_classes().empty()) {
+                            throw std::runtime_error("No ClientClass in image, its netvars are built at runtime.");
+                        }
+
+                        const auto props = graph->find_table(data.get_table());
+                        if (!props) {
+                            throw std::runtime_error("Failed finding netvar table.");
+                        }
+
+                        if (props->empty()) {
+                            throw std::runtime_error("Netvar table has no props in image.");
+                        }
+
+                        // flattened tables repeat names nested ones share,
+                        // the outermost, first walked, one is kept
+                        auto& table = table_entries[utility::code::to_identifier(key)];
+                        for (const auto& [name, offset] : *props) {
+                            table.try_emplace(utility::code::to_identifier(name), offset);
+                        }
+
+                        metrics::observe(metrics::id::entry_seconds, "netvars", timer.get_elapsed());
+                    };
+
+                    // every entry, with what planning needs to know of it. patterns
+                    // are compiled here, once for both the passes and the entries
+                    std::vector<plan::entry> entries                                        = {};
+                    std::vector<std::pair<const std::string*, const nlohmann::json*>> items = {};
+                    std::pmr::vector<pattern::context> patterns(&scratch);
+
+                    patterns.reserve(signatures.size());
+
+                    const auto add = [&](plan::kind type, const nlohmann::json& list, const auto& describe) {
+                        for (const auto& [key, value] : list.items()) {
+                            attempt(failed, key, [&]() {
+                                items.emplace_back(&key, &value);
+
+                                plan::entry planned = {type, items.size() - 1, key, plan::identify(dll.get_hash(), type, std::hash<nlohmann::json> {}(value))};
+                                describe(planned, value);
+                                entries.push_back(planned);
+                            });
+                        }
+                    };
+
+                    add(plan::kind::signature, signatures, [&](plan::entry& planned, const nlohmann::json& value) {
+                        const auto& data = utility::json::signature(value);
+
+                        patterns.emplace_back(data.get_signature(), &scratch);
+                        planned.section   = ".text";
+                        planned.pattern   = &patterns.back();
+                        planned.nth_match = data.get_nth_match();
+                    });
+
+                    add(plan::kind::string_search, string_search, [&](plan::entry& planned, const nlohmann::json& value) {
+                        const auto& data = utility::json::string_search(value);
+
+                        planned.section = data.get_section();
+                        planned.string  = data.get_string();
+                    });
+
+                    add(plan::kind::procedure, procedures, [](plan::entry&, const nlohmann::json&) {});
+
+                    add(plan::kind::convar, convars, [&](plan::entry& planned, const nlohmann::json& value) {
+                        planned.section = ".text";
+                        planned.string  = utility::json::convar(value).get_name();
+                    });
+
+                    add(plan::kind::vtable, vtables, [](plan::entry& planned, const nlohmann::json&) {
+                        planned.section = ".rdata";
+                    });
+
+                    add(plan::kind::registration, registrations, [](plan::entry& planned, const nlohmann::json&) {
+                        planned.section = ".data";
+                    });
+
+                    add(plan::kind::netvar, netvar_tables, [](plan::entry& planned, const nlohmann::json&) {
+                        planned.section = ".data";
+                    });
+
+                    const plan::context planned(dll, std::move(entries), past);
+                    if (arguments::explain) {
+                        std::stringstream report = {};
+                        planned.explain(report, keys[index]);
+                        std::cout << report.str();
+                    }
+
+                    dll.set_cancel(&scope);
+                    const auto shares = planned.run(dll, &scratch);
+                    dll.set_cancel(nullptr);
+
+                    // modules identical to the first of their group
+                    // are memo lookups, only the first one is timed
+                    const auto timed = (index == groups[job.index].front());
+
+                    for (size_t i = 0; i < planned.get_entries().size(); ++i) {
+                        const auto& step         = planned.get_entries()[i];
+                        const auto& [key, value] = items[step.index];
+                        const auto begin         = std::chrono::steady_clock::now();
+
+                        attempt(failed, *key, [&]() {
+                            switch (step.type) {
+                                case plan::kind::signature: {
+                                    resolve_signature(*key, *value, *step.pattern);
+                                } break;
+                                case plan::kind::string_search: {
+                                    resolve_string_search(*key, *value);
+                                } break;
+                                case plan::kind::procedure: {
+                                    resolve_procedure(*key, *value);
+                                } break;
+                                case plan::kind::convar: {
+                                    resolve_convar(*key, *value);
+                                } break;
+                                case plan::kind::vtable: {
+                                    resolve_vtable(*key, *value);
+                                } break;
+                                case plan::kind::registration: {
+                                    resolve_registration(*key, *value);
+                                } break;
+                                case plan::kind::netvar: {
+                                    resolve_netvar(*key, *value);
+                                } break;
+                            }
+                        });
+
+                        if (timed && !failed.contains(*key)) {
+                            past.record(step.id, std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() + shares[i]);
+                        }
+                    }
+                }
+
+                // unmaps module, giving its share back to the budget
+                contexts[job.index].reset();
+                scheduler.release(job);
+            }
+        };
+
+#ifdef ALTDUMPER_COUNT_ALLOCATIONS
+        const size_t allocations = utility::allocations::count;
+#endif
+
+        std::vector<std::thread> thread_pool = {};
+
+        thread_pool.emplace_back(load);
+        for (auto i = 0; i < workers; ++i) {
+            thread_pool.emplace_back(work);
+        }
+
+        // run thread pool
+        for (auto& thread : thread_pool) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+
+        past.save();
+
+#ifdef ALTDUMPER_COUNT_ALLOCATIONS
+        const auto allocated = utility::allocations::count - allocations;
+        std::cout << "Heap allocations while resolving: " << allocated << " (" << ((double)allocated / std::max<size_t>(entries, 1)) << " per entry)\n";
+#endif
+
+        return out;
+    }
+
+    /**
+     * @brief Get results of config where every entry failed, for modules
+     * that couldn't be resolved at all
+     * 
+     * @param config Config, or the part of one
+     * @param why Why, given as every entry's status
+     * @return results Results, every module in config having its maps
+     */
+    [[nodiscard]] results failed(const nlohmann::json& config, const std::string& why) {
+        results out = {};
+
+        for (const auto& [key, value] : config.items()) {
+            out.addresses[key];
+            out.tables[key];
+
+            auto& failures = out.failures[key];
+            for (const auto& type : {"signatures", "string-search", "procedures", "convars", "vtables", "netvars", "interfaces"}) {
+                if (!value.contains(type)) {
+                    continue;
+                }
+
+                for (const auto& [entry, data] : value[type].items()) {
+                    failures[entry] = why;
+                }
+            }
+        }
+
+        return out;
+    }
+
+    // limits and results go to and from worker processes as fleet messages,
+    // taken apart in the order they're put together
+
+    void pack(fleet::writer& out, const options& limits) {
+        out.put((uint64_t)limits.budget).put((uint64_t)limits.window);
+        out.put(limits.entry_time).put((uint64_t)limits.entry_bytes);
+        out.put(limits.module_time).put((uint64_t)limits.module_bytes);
+    }
+
+    void unpack(fleet::reader& in, options& limits) {
+        limits.budget       = (size_t)in.take<uint64_t>();
+        limits.window       = (size_t)in.take<uint64_t>();
+        limits.entry_time   = in.take<double>();
+        limits.entry_bytes  = (size_t)in.take<uint64_t>();
+        limits.module_time  = in.take<double>();
+        limits.module_bytes = (size_t)in.take<uint64_t>();
+    }
+
+    void pack(fleet::writer& out, const results& dumped) {
+        out.put((uint32_t)dumped.addresses.size());
+        for (const auto& [dll, entries] : dumped.addresses) {
+            out.put(dll).put((uint32_t)entries.size());
+            for (const auto& [entry, address] : entries) {
+                out.put(entry).put((uint64_t)address);
+            }
+        }
+
+        out.put((uint32_t)dumped.tables.size());
+        for (const auto& [dll, tables] : dumped.tables) {
+            out.put(dll).put((uint32_t)tables.size());
+            for (const auto& [table, props] : tables) {
+                out.put(table).put((uint32_t)props.size());
+                for (const auto& [prop, offset] : props) {
+                    out.put(prop).put((uint64_t)offset);
+                }
+            }
+        }
+
+        out.put((uint32_t)dumped.failures.size());
+        for (const auto& [dll, failures] : dumped.failures) {
+            out.put(dll).put((uint32_t)failures.size());
+            for (const auto& [entry, why] : failures) {
+                out.put(entry).put(why);
+            }
+        }
+    }
+
+    void unpack(fleet::reader& in, results& dumped) {
+        for (auto dlls = in.take<uint32_t>(); dlls; --dlls) {
+            auto& entries = dumped.addresses[in.take_string()];
+            for (auto count = in.take<uint32_t>(); count; --count) {
+                auto entry     = in.take_string();
+                entries[entry] = (uintptr_t)in.take<uint64_t>();
+            }
+        }
+
+        for (auto dlls = in.take<uint32_t>(); dlls; --dlls) {
+            auto& tables = dumped.tables[in.take_string()];
+            for (auto count = in.take<uint32_t>(); count; --count) {
+                auto& props = tables[in.take_string()];
+                for (auto left = in.take<uint32_t>(); left; --left) {
+                    auto prop   = in.take_string();
+                    props[prop] = (uintptr_t)in.take<uint64_t>();
+                }
+            }
+        }
+
+        for (auto dlls = in.take<uint32_t>(); dlls; --dlls) {
+            auto& failures = dumped.failures[in.take_string()];
+            for (auto count = in.take<uint32_t>(); count; --count) {
+                auto entry      = in.take_string();
+                failures[entry] = in.take_string();
+            }
+        }
+    }
+
+    /**
+     * @brief Generate headers from results, one per module namespace and one
+     * including them all at path. Each is only written when it changed, and
+     * when and by what build the dump was made goes to a stamp file beside
+     * them, so offsets that didn't move don't rebuild what includes them
+     * 
+     * @param path Umbrella header, module headers are named after it
+     * @param config_name Config the results come from
+     * @param dumped Results
+     */
+    void generate(const std::string& path, const std::string& config_name, const results& dumped) {
+        const std::filesystem::path umbrella = path;
+
+        const auto folder    = umbrella.parent_path();
+        const auto stem      = umbrella.stem().string();
+        const auto extension = umbrella.extension().string();
+
+        // modules by namespace, a name shared by modules in different
+        // folders is one namespace, in one header
+        std::map<std::string, std::vector<std::string>> namespaces = {};
+        for (const auto& [dll, entries] : dumped.addresses) {
+            // serialize name
+            auto begin             = dll.rfind("\\") + 1;
+            auto&& serialized_name = dll.substr(begin);
+            auto end               = serialized_name.rfind(".");
+            serialized_name        = serialized_name.substr(0, end);
+
+            namespaces[serialized_name].push_back(dll);
+        }
+
+        code_gen::context header(path);
+        header.break_line();
+        header.comment(config_name);
+
+        // values will all be addresses, and we want them to be printed
+        // in hexadecimal, for ease
+        // TODO: consider making the spew JSON? so it's inherently more
+        // universal than the code-gen allows for
+        std::cout << std::hex;
+        for (const auto& [serialized_name, dlls] : namespaces) {
+            const auto file_name = stem + '_' + serialized_name + extension;
+            header.include(file_name);
+
+            // initialize code generation context with filesystem input
+            code_gen::context output((folder / file_name).string());
+
+            // namespace/scope for the whole context
+            output.break_line();
+            output.comment(config_name);
+            output.push_namespace("altdumper");
+
+            for (const auto& dll : dlls) {
+                // start namespace/scope with dll name with no extensions, comment
+                // full path right before
+                output.comment(dll);
+                output.push_namespace(serialized_name);
+
+                std::cout << "[+] " << dll << " (" << serialized_name << ")\n";
+
+                for (const auto& [entry, value] : dumped.addresses.at(dll)) {
+                    output.push_value(entry, value);
+                    std::cout << "[-]\t" << entry << '=' << value << '\n';
+                }
+
+                // left out of the values, so code using them fails to build
+                // rather than reading a wrong address
+                for (const auto& [entry, status] : dumped.failures.at(dll)) {
+                    output.comment(entry + ": " + status);
+                    std::cout << "[!]\t" << entry << ": " << status << '\n';
+                }
+
+                // props are offsets into their table's class, not addresses
+                if (const auto& netvar_tables = dumped.tables.at(dll); !netvar_tables.empty()) {
+                    output.push_namespace("netvars");
+
+                    for (const auto& [table, props] : netvar_tables) {
+                        output.push_namespace(table);
+
+                        for (const auto& [prop, offset] : props) {
+                            output.push_value(prop, offset);
+                            std::cout << "[-]\t" << table << "::" << prop << '=' << offset << '\n';
+                        }
+
+                        output.pop_scope();
                     }
 
-                    return bytes;
-                };
+                    output.pop_scope();
+                }
+
+                // pop dll namespace/scope
+                output.pop_scope();
+            }
+
+            // pop whole context namespace/scope
+            output.pop_scope();
+
+            std::cout << (output.save() ? "[*] Wrote " : "[=] Unchanged ") << file_name << '\n';
+        }
+
+        std::cout << (header.save() ? "[*] Wrote " : "[=] Unchanged ") << umbrella.filename().string() << '\n';
+
+        // changes every dump, nothing includes it. replaced the way
+        // headers are, so it's never left half written either
+        const auto stamp = folder / (stem + ".stamp");
+        const auto now   = std::time(nullptr);
+
+        auto temporary = stamp;
+        temporary += '.' + std::to_string(GetCurrentProcessId()) + ".tmp";
+
+        auto written = false;
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            file << "altdumper - " __TIMESTAMP__ "\n"
+                 << "dumped - " << std::put_time(std::localtime(&now), "%c") << '\n';
+            written = file.good();
+        }
+
+        std::error_code error = {};
+        if (written) {
+            std::filesystem::rename(temporary, stamp, error);
+        }
+
+        if (!written || error) {
+            std::filesystem::remove(temporary, error);
+            throw std::runtime_error("Failed writing " + stamp.string());
+        }
+    }
+}  // namespace dump
+
+[[nodiscard]] int make() {
+    std::cout << "Provide config file:\n";
+    auto&& config_name = utility::winapi::get_file_from_prompt();
+
+    // open stream
+    std::ifstream file(config_name);
+
+    // parse stream as json
+    const nlohmann::json& config = nlohmann::json::parse(file);
+
+    // make file editable/free again, as contents've been copied
+    file.close();
+
+    const auto limits = dump::prompt_options();
+
+    // scans check in with the run's scope, which Ctrl+C stops. what's
+    // resolved by then is still written
+    cancel::context run = {};
+    utility::winapi::set_interrupt(&run);
+
+    const auto dumped = dump::resolve(config, limits, run);
+    utility::winapi::set_interrupt(nullptr);
+
+    // get saved output folder
+    std::cout << "You'll be prompted to provide a folder where your code generation result will be saved:\n";
+    auto&& path = utility::winapi::get_folder_from_prompt();
+
+    // store file name
+    std::cout << "Input a file name (with extension):\n";
+    std::string file_name = {};
+    std::getline(std::cin >> std::ws, file_name);
+
+    dump::generate(path + file_name, config_name, dumped);
+
+#ifdef ALTDUMPER_METRICS
+    // scraped by whoever runs us on a schedule
+    metrics::write(path + "altdumper.metrics");
+    std::cout << "Metrics written to " << path << "altdumper.metrics.prom (and .json)\n";
+#endif
+
+    return EXIT_SUCCESS;
+}
+
+[[nodiscard]] int watch() {
+    // an updater writes a module in bursts, it's only read back once it's
+    // been left alone this long. changes are checked for this often, more
+    // often when notifications come in
+    constexpr auto settle    = std::chrono::seconds(3);
+    constexpr DWORD interval = 1000;
+
+    if (arguments::captured.has_value()) {
+        throw std::runtime_error("Watching follows modules on disk, a snapshot doesn't change.");
+    }
+
+    std::cout << "Provide config file:\n";
+    auto&& config_name = utility::winapi::get_file_from_prompt();
+
+    std::ifstream file(config_name);
+    const nlohmann::json& config = nlohmann::json::parse(file);
+    file.close();
+
+    const auto limits = dump::prompt_options();
+
+    std::cout << "You'll be prompted to provide a folder where your code generation result will be saved:\n";
+    auto&& path = utility::winapi::get_folder_from_prompt();
+
+    std::cout << "Input a file name (with extension):\n";
+    std::string file_name = {};
+    std::getline(std::cin >> std::ws, file_name);
+
+    // what each module looked like on disk, and hashed to, when last resolved
+    struct stamp {
+        //
+        // DATA
+        //
+
+        std::filesystem::file_time_type written = {};
+        uintmax_t size                          = 0;
+        uint64_t hash                           = 0;
+    };
 
-                uintptr_t address = 0;
+    const auto& stat = [](const std::string& dll) {
+        std::error_code error = {};
 
-                auto&& vec      = pattern_to_bytes(data.get_signature());
-                const auto& sig = dll.find_signature(vec.data(), vec.size(), ".text", data.get_nth_match());
-                if (sig.has_value()) {
-                    address = (sig.value().padded(data.get_padding()).dereferenced(data.get_dereferences()).get() - (uintptr_t)dll.get_bytes());
-                } else {
-                    // well, we can still continue. but, this is decided by
-                    // the one who handles the errors. rawly, upon catches we
-                    // just
-                    throw std::runtime_error("Failed finding pattern.");
+        stamp out   = {};
+        out.written = std::filesystem::last_write_time(dll, error);
+        out.size    = std::filesystem::file_size(dll, error);
+        return out;
+    };
+
+    std::map<std::string, stamp> stamps = {};
+
+    // every module's results, unchanged ones carried from round to round
+    dump::results kept = {};
+
+    // a notification per folder holding a module. if any can't be
+    // had, or there are more than can be waited on, it's all polled
+    std::vector<HANDLE> notifications = {};
+    std::set<std::string> folders     = {};
+    for (const auto& [key, value] : config.items()) {
+        folders.insert(std::filesystem::path(key).parent_path().string());
+    }
+
+    for (const auto& folder : folders) {
+        const auto notification = FindFirstChangeNotificationA(folder.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME);
+        if (notification == INVALID_HANDLE_VALUE || notifications.size() == MAXIMUM_WAIT_OBJECTS) {
+            if (notification != INVALID_HANDLE_VALUE) {
+                FindCloseChangeNotification(notification);
+            }
+
+            std::cout << "[~] Can't be notified of changes in " << folder << ", polling instead\n";
+            for (auto handle : notifications) {
+                FindCloseChangeNotification(handle);
+            }
+
+            notifications.clear();
+            break;
+        }
+
+        notifications.push_back(notification);
+    }
+
+    // Ctrl+C stops both the round in flight and watching
+    cancel::context run = {};
+    utility::winapi::set_interrupt(&run);
+
+    std::cout << "Watching " << config.size() << " module(s), Ctrl+C to stop.\n";
+
+    auto first = true;
+    while (!run.is_stopped()) {
+        if (!first) {
+            if (notifications.empty()) {
+                Sleep(interval);
+            } else {
+                const auto signalled = WaitForMultipleObjects((DWORD)notifications.size(), notifications.data(), FALSE, interval);
+                if (signalled >= WAIT_OBJECT_0 && signalled < (WAIT_OBJECT_0 + notifications.size())) {
+                    FindNextChangeNotification(notifications[signalled - WAIT_OBJECT_0]);
                 }
+            }
+        }
+
+        // modules written to since they were last resolved
+        std::vector<std::string> touched = {};
+        for (const auto& [key, value] : config.items()) {
+            const auto now = stat(key);
+            if (first || !stamps.contains(key) || stamps[key].written != now.written || stamps[key].size != now.size) {
+                touched.push_back(key);
+            }
+        }
+
+        if (touched.empty()) {
+            continue;
+        }
 
-                map_entry_key[key] = address;
+        // wait for the updater to be done with them
+        auto quiet = std::chrono::steady_clock::now();
+        auto last  = std::vector<stamp> {};
+        while (!first && !run.is_stopped()) {
+            std::vector<stamp> current = {};
+            for (const auto& key : touched) {
+                current.push_back(stat(key));
             }
 
-            for (const auto& [key, value] : string_search.items()) {
-                const auto& data = utility::json::string_search(value);
+            const auto same = std::ranges::equal(current, last, [](const stamp& left, const stamp& right) {
+                return left.written == right.written && left.size == right.size;
+            });
+
+            if (!same) {
+                last  = std::move(current);
+                quiet = std::chrono::steady_clock::now();
+            } else if ((std::chrono::steady_clock::now() - quiet) >= settle) {
+                break;
+            }
 
-                uintptr_t address = 0;
+            Sleep(interval / 4);
+        }
 
-                auto&& str      = data.get_string();
-                const auto& ptr = dll.find_string(str.c_str(), str.size(), data.get_section(), data.get_reference_instance());
-                if (ptr.has_value()) {
-                    address = (ptr.value().padded(data.get_padding()).dereferenced(data.get_dereferences()).get() - (uintptr_t)dll.get_bytes());
-                } else {
-                    throw std::runtime_error("Failed finding string.");
+        // a rewrite with the same bytes, like a verify pass, is left alone
+        nlohmann::json round = nlohmann::json::object();
+        std::vector<std::pair<std::string, stamp>> changed = {};
+        try {
+            for (const auto& key : touched) {
+                auto now = stat(key);
+                now.hash = modules::context(key).get_hash();
+
+                if (!first && stamps.contains(key) && stamps[key].hash == now.hash) {
+                    stamps[key] = now;
+                    continue;
                 }
 
-                map_entry_key[key] = address;
+                round[key] = config[key];
+                changed.emplace_back(key, now);
+            }
+        } catch (const std::exception& error) {
+            // still being written, or gone for now. tried again next change
+            std::cout << "[~] " << error.what() << '\n';
+            first = false;
+            continue;
+        }
+
+        first = false;
+        if (changed.empty()) {
+            continue;
+        }
+
+        std::cout << "[*] Resolving " << changed.size() << " changed module(s)\n";
+
+        try {
+            auto dumped = dump::resolve(round, limits, run);
+
+            // a round cut short isn't written over the last complete one
+            if (run.is_stopped()) {
+                break;
+            }
+
+            for (auto& [key, now] : changed) {
+                kept.addresses.insert_or_assign(key, std::move(dumped.addresses[key]));
+                kept.tables.insert_or_assign(key, std::move(dumped.tables[key]));
+                kept.failures.insert_or_assign(key, std::move(dumped.failures[key]));
+                stamps[key] = now;
             }
 
-            for (const auto& [key, value] : procedures.items()) {
-                const auto& data = utility::json::procedure(value);
+            dump::generate(path + file_name, config_name, kept);
+        } catch (const std::exception& error) {
+            std::cout << "[!] " << error.what() << '\n';
+        }
 
-                uintptr_t address = 0;
+        std::cout << std::dec << "[*] Watching, Ctrl+C to stop.\n";
+    }
 
-                auto&& name     = data.get_name();
-                const auto& ptr = dll.find_procedure(name);
-                if (ptr.has_value()) {
-                    address = (ptr.value().get() - (uintptr_t)dll.get_bytes());
-                } else {
-                    throw std::runtime_error("Failed finding procedure.");
+    utility::winapi::set_interrupt(nullptr);
+    for (auto handle : notifications) {
+        FindCloseChangeNotification(handle);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+[[nodiscard]] int shard() {
+    // a module whose worker died is tried again on a fresh one, once. dying
+    // on it twice over is the module's doing, and it's left failed
+    constexpr size_t attempts = 2;
+
+    // a worker is given this many times a module's time, and this many
+    // seconds more to load it, before it's taken as hung and terminated
+    constexpr double patience = 2;
+    constexpr double slack    = 30;
+
+    std::cout << "You'll be prompted to provide a folder with the configs to make:\n";
+    auto&& configs_folder = utility::winapi::get_folder_from_prompt();
+
+    // sorted, so work is handed out and merged the same from run to run
+    std::vector<std::filesystem::path> names = {};
+    for (const auto& file : std::filesystem::directory_iterator(configs_folder)) {
+        if (file.is_regular_file() && (file.path().extension() == ".json")) {
+            names.push_back(file.path());
+        }
+    }
+
+    std::ranges::sort(names);
+
+    // a config that doesn't parse is left out, the rest are still made
+    std::vector<std::pair<std::filesystem::path, nlohmann::json>> configs = {};
+    for (const auto& name : names) {
+        try {
+            std::ifstream file(name);
+            configs.emplace_back(name, nlohmann::json::parse(file));
+        } catch (const std::exception& error) {
+            std::cout << "[!] " << name.string() << ": " << error.what() << '\n';
+        }
+    }
+
+    if (configs.empty()) {
+        throw std::runtime_error("No configs in " + configs_folder);
+    }
+
+    const auto limits = dump::prompt_options();
+
+    size_t count = 0;
+
+workers_label:
+    std::cout << "Worker processes (0 for one per core):\n";
+    std::cin >> count;
+
+    if (std::cin.fail()) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<int>::max(), '\n');
+        goto workers_label;
+    }
+
+    std::cout << "You'll be prompted to provide a folder where your code generation results will be saved:\n";
+    auto&& path = utility::winapi::get_folder_from_prompt();
+
+    // each config's headers are named after it
+    std::cout << "Input an extension for the headers (like .hh):\n";
+    std::string extension = {};
+    std::getline(std::cin >> std::ws, extension);
+
+    // work is handed out a module at a time, so one big config is spread
+    // as well as many small ones, and a worker dying costs one module
+    struct item {
+        //
+        // DATA
+        //
+
+        std::string key     = {};
+        nlohmann::json part = nlohmann::json::object();
+        size_t tries        = 0;
+
+        // configs it's resolved for, with their own entries of it
+        std::vector<std::pair<size_t, const nlohmann::json*>> configs = {};
+    };
+
+    // a module several configs list is resolved once for all of them, their
+    // entries joined. an entry named the same as a different one of another
+    // config's can't share its results, that config gets a shard of its own
+    const auto joins = [](const nlohmann::json& into, const nlohmann::json& value) {
+        for (const auto& [type, entries] : value.items()) {
+            if (!entries.is_object()) {
+                if (into.contains(type) && (into.at(type) != entries)) {
+                    return false;
                 }
 
-                map_entry_key[key] = address;
+                continue;
+            }
+
+            for (const auto& [entry, data] : entries.items()) {
+                for (const auto& [other, list] : into.items()) {
+                    if (list.is_object() && list.contains(entry) && ((other != type) || (list.at(entry) != data))) {
+                        return false;
+                    }
+                }
             }
+        }
 
-            for (const auto& [key, value] : convars.items()) {
-                const auto& data = utility::json::convar(value);
+        return true;
+    };
 
-                uintptr_t address = 0;
+    std::vector<item> shards                                  = {};
+    std::unordered_map<std::string, std::vector<size_t>> seen = {};
+    for (size_t i = 0; i < configs.size(); ++i) {
+        for (const auto& [key, value] : configs[i].second.items()) {
+            auto& candidates = seen[key];
+            const auto found = std::ranges::find_if(candidates, [&](size_t index) {
+                return joins(shards[index].part.at(key), value);
+            });
+
+            const auto index = (found != candidates.end()) ? *found : shards.size();
+            if (index == shards.size()) {
+                candidates.push_back(index);
+                shards.push_back({key});
+            }
 
-                auto&& name     = data.get_name();
-                const auto& ptr = dll.find_convar(name.c_str(), name.size(), data.get_server_bounded());
-                if (ptr.has_value()) {
-                    address = (ptr.value().get() - (uintptr_t)dll.get_bytes());
+            auto& module = shards[index];
+            auto& joined = module.part[key];
+            for (const auto& [type, entries] : value.items()) {
+                if (entries.is_object()) {
+                    joined[type].update(entries);
                 } else {
-                    throw std::runtime_error("Failed finding convar.");
+                    joined[type] = entries;
+                }
+            }
+
+            module.configs.emplace_back(i, &value);
+        }
+    }
+
+    const auto workers = std::min<size_t>(count ? count : std::max(1u, std::thread::hardware_concurrency()), shards.size());
+
+    // each worker resolves one module at a time, under its share of the budget
+    auto shared   = limits;
+    shared.budget = limits.budget ? std::max<size_t>(limits.budget / std::max<size_t>(workers, 1), 1) : 0;
+
+    // without a module time, a worker is waited on however long it takes
+    const auto deadline = (shared.module_time > 0) ? (DWORD)((shared.module_time * patience + slack) * 1000) : INFINITE;
+
+    // workers are this very executable, reading modules as we were told to
+    char executable[MAX_PATH] = {};
+    GetModuleFileNameA(nullptr, executable, MAX_PATH);
+    const auto command = '"' + std::string {executable} + "\" " + arguments::forwarded + "--worker";
+
+    // results by shard, merged in shard order once every one is in
+    std::vector<std::optional<dump::results>> done(shards.size());
+    std::deque<size_t> pending = {};
+    std::mutex mutex           = {};
+    for (size_t i = 0; i < shards.size(); ++i) {
+        pending.push_back(i);
+    }
+
+    // Ctrl+C reaches workers too, which reply with what they've resolved by
+    // then. what wasn't handed out by then isn't
+    cancel::context run = {};
+    utility::winapi::set_interrupt(&run);
+
+    // keeps one worker busy, starting another whenever the last one died
+    const auto& dispatch = [&]() {
+        std::unique_ptr<fleet::context> worker = nullptr;
+
+        for (;;) {
+            size_t index = 0;
+            {
+                std::scoped_lock lock(mutex);
+                if (pending.empty() || run.is_stopped()) {
+                    return;
                 }
 
-                map_entry_key[key] = address;
+                index = pending.front();
+                pending.pop_front();
             }
-        };
 
-        thread_pool.push_back(std::thread {work});
+            auto& module = shards[index];
+
+            // limits, then the module's part of its config
+            fleet::writer request = {};
+            dump::pack(request, shared);
+
+            const auto part = nlohmann::json::to_cbor(module.part);
+            request.put(std::string_view {(const char*)part.data(), part.size()});
+
+            std::optional<dump::results> replied = std::nullopt;
+            std::string why                      = "worker exited";
+            try {
+                if (!worker) {
+                    worker = std::make_unique<fleet::context>(command);
+                }
+
+                if (worker->send(request.bytes)) {
+                    if (const auto reply = worker->receive(deadline); reply.has_value()) {
+                        fleet::reader message = {reply.value()};
+
+                        dump::results dumped = {};
+                        dump::unpack(message, dumped);
+                        replied = std::move(dumped);
+                    }
+                }
+            } catch (const std::exception& error) {
+                // not started, or replied with what doesn't make sense
+                why = error.what();
+            }
+
+            if (replied.has_value()) {
+                std::scoped_lock lock(mutex);
+                done[index] = std::move(replied);
+                continue;
+            }
+
+            // died with the module in flight. the next one's
+            // handed to a fresh worker, and so is this one again
+            if (worker) {
+                if (worker->has_timed_out()) {
+                    why = "worker timed out";
+                } else if (const auto code = worker->get_exit_code(); code.has_value()) {
+                    std::stringstream exited = {};
+                    exited << "worker exited with 0x" << std::hex << code.value();
+                    why = exited.str();
+                }
+
+                worker.reset();
+            }
+
+            const auto& key = module.part.begin().key();
+
+            std::scoped_lock lock(mutex);
+            if ((++module.tries < attempts) && !run.is_stopped()) {
+                std::cout << "[~] " << key << ": " << why << ", trying again\n";
+                pending.push_back(index);
+            } else {
+                done[index] = dump::failed(module.part, why);
+            }
+        }
+    };
+
+    std::cout << "[*] Making " << configs.size() << " config(s), " << shards.size() << " module(s), across " << workers << " worker(s)\n";
+
+    std::vector<std::thread> thread_pool = {};
+    for (auto i = 0; i < workers; ++i) {
+        thread_pool.emplace_back(dispatch);
     }
 
-    // run thread pool
     for (auto& thread : thread_pool) {
         if (thread.joinable()) {
             thread.join();
         }
     }
 
-    // get saved output folder
-    std::cout << "You'll be prompted to provide a folder where your code generation result will be saved:\n";
-    auto&& path = utility::winapi::get_folder_from_prompt();
+    utility::winapi::set_interrupt(nullptr);
 
-    // store file name
-    std::cout << "Input a file name (with extension):\n";
-    std::string file_name = {};
-    std::getline(std::cin >> std::ws, file_name);
+    // modules in one config are distinct keys, so merging only ever adds.
+    // each config a shard was resolved for gets only its own entries of it
+    std::vector<dump::results> merged(configs.size());
+    for (size_t i = 0; i < shards.size(); ++i) {
+        if (!done[i].has_value()) {
+            done[i] = dump::failed(shards[i].part, std::string {cancel::describe(cancel::reason::cancelled)});
+        }
+
+        const auto& key     = shards[i].key;
+        const auto& results = done[i].value();
+
+        const auto copy = [&](const auto& from, auto& to, const std::string& entry) {
+            if (const auto module = from.find(key); module != from.end()) {
+                if (const auto found = module->second.find(entry); found != module->second.end()) {
+                    to[key].insert(*found);
+                }
+            }
+        };
+
+        for (const auto& [config, value] : shards[i].configs) {
+            auto& out = merged[config];
+            out.addresses[key];
+            out.tables[key];
+            out.failures[key];
+
+            for (const auto& [type, entries] : value->items()) {
+                if (!entries.is_object()) {
+                    continue;
+                }
+
+                for (const auto& [entry, data] : entries.items()) {
+                    copy(results.addresses, out.addresses, entry);
+                    copy(results.tables, out.tables, entry);
+                    copy(results.failures, out.failures, entry);
+                }
+            }
+        }
+    }
+
+    // a config whose headers can't be written doesn't keep the rest from being
+    for (size_t i = 0; i < configs.size(); ++i) {
+        const auto& name = configs[i].first;
+        try {
+            dump::generate(path + name.stem().string() + extension, name.string(), merged[i]);
+        } catch (const std::exception& error) {
+            std::cout << "[!] " << error.what() << '\n';
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Resolve what a coordinating process sends, until it closes its pipe
+ * 
+ * @param in Pipe requests come in through
+ * @param out Pipe replies go out through
+ * @return int Status
+ */
+[[nodiscard]] int serve(HANDLE in, HANDLE out) {
+    cancel::context run = {};
+    utility::winapi::set_interrupt(&run);
+
+    while (const auto request = fleet::receive(in)) {
+        fleet::reader message = {request.value()};
+
+        dump::options limits = {};
+        dump::unpack(message, limits);
+
+        const auto config = nlohmann::json::from_cbor(message.take_string());
+
+        // a module that doesn't even load fails every entry of
+        // it, rather than the worker, which has more to do
+        dump::results dumped = {};
+        try {
+            dumped = dump::resolve(config, limits, run);
+        } catch (const std::exception& error) {
+            dumped = dump::failed(config, error.what());
+        }
+
+        fleet::writer reply = {};
+        dump::pack(reply, dumped);
+        if (!fleet::send(out, reply.bytes)) {
+            break;
+        }
+    }
+
+    utility::winapi::set_interrupt(nullptr);
+    return EXIT_SUCCESS;
+}
+
+[[nodiscard]] int verify() {
+    // a scan may take this much longer than the golden run's before it counts
+    // as a regression. the slack keeps timer noise on tiny scans out of it
+    constexpr double budget_margin = 1.5;
+    constexpr double budget_slack  = 50.0;
+    constexpr size_t timed_runs    = 5;
+
+    std::cout << "Provide config file:\n";
+    auto&& config_name = utility::winapi::get_file_from_prompt();
+
+    std::ifstream file(config_name);
+    const nlohmann::json& config = nlohmann::json::parse(file);
+    file.close();
+
+    std::cout << "Provide golden file to compare against (cancel to write a new one next to the config):\n";
+    auto&& golden_name = utility::winapi::get_file_from_prompt();
+
+    nlohmann::json golden = nlohmann::json::object();
+    if (!golden_name.empty()) {
+        std::ifstream stream(golden_name);
+        golden = nlohmann::json::parse(stream);
+    }
+
+    // raw scan results, before padding and dereferences, which is
+    // what an engine change could move. and the best of a few timings
+    nlohmann::json current = nlohmann::json::object();
+    size_t failures        = 0;
+
+    const auto& record = [&](const std::string& dll, const std::string& entry, std::optional<uintptr_t> rva, double microseconds) {
+        auto& node = current[dll][entry];
+        node       = {{"rva", rva.has_value() ? nlohmann::json(rva.value()) : nlohmann::json(nullptr)}, {"microseconds", microseconds}};
+
+        if (!golden.contains(dll) || !golden[dll].contains(entry)) {
+            return;
+        }
+
+        const auto& expected = golden[dll][entry];
+        if (expected["rva"] != node["rva"]) {
+            std::cout << "[!] " << dll << ": " << entry << " resolved to " << node["rva"] << ", golden run had " << expected["rva"] << '\n';
+            ++failures;
+        }
+
+        const auto budget = (expected["microseconds"].get<double>() * budget_margin) + budget_slack;
+        if (microseconds > budget) {
+            std::cout << "[!] " << dll << ": " << entry << " took " << microseconds << "us, budget is " << budget << "us\n";
+            ++failures;
+        }
+    };
+
+    for (const auto& [key, value] : config.items()) {
+        const auto module = dump::open_module(key);
+        auto& dll         = *module;
+
+        const auto rva = [&](const std::optional<ptr>& found) {
+            return found.has_value() ? std::optional<uintptr_t> {found.value().get() - (uintptr_t)dll.get_bytes()} : std::nullopt;
+        };
+
+        // every run scans again, rather than looking up the matches of the last
+        const auto& time = [&](const auto& scan) {
+            auto best = std::numeric_limits<double>::max();
+            for (size_t i = 0; i < timed_runs; ++i) {
+                dll.clear_matches();
+
+                const auto start = std::chrono::steady_clock::now();
+                scan();
+                best = std::min(best, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+
+            return best;
+        };
+
+        if (value.contains("signatures")) {
+            for (const auto& [entry, data] : value["signatures"].items()) {
+                const auto& signature = utility::json::signature(data);
+
+                auto compiled = pattern::context(signature.get_signature());
 
-    // initialize code generation context with filesystem input
-    code_gen::context output(path + file_name);
+                dll.clear_matches();
+                auto found = rva(dll.find_signature(compiled, ".text", signature.get_nth_match()));
 
-    // intro`
-    output.break_line(2);
-    output.comment("altdumper - " __TIMESTAMP__);
-    output.break_line(2);
+                // every engine has to agree with the one picked
+                for (const auto& [which, other_found] : dll.find_signature_each(compiled, ".text", signature.get_nth_match())) {
+                    if (const auto& other = rva(other_found); other != found) {
+                        std::cout << "[!] " << key << ": " << entry << " engines disagree, " << pattern::describe(which) << " found " << (other.has_value() ? std::to_string(other.value()) : "nothing") << '\n';
+                        ++failures;
+                    }
+                }
+
+                record(key, "signatures/" + entry, found, time([&]() {
+                           return dll.find_signature(compiled, ".text", signature.get_nth_match());
+                       }));
+            }
+        }
+
+        if (value.contains("string-search")) {
+            for (const auto& [entry, data] : value["string-search"].items()) {
+                const auto& search = utility::json::string_search(data);
+                const auto& scan   = [&]() -> std::optional<ptr> {
+                    // a string which isn't there is a result like any other here
+                    try {
+                        return dll.find_string(search.get_string(), search.get_section(), search.get_reference_instance());
+                    } catch (const std::runtime_error&) {
+                        return std::nullopt;
+                    }
+                };
+
+                record(key, "string-search/" + entry, rva(scan()), time(scan));
+            }
+        }
+
+        if (value.contains("procedures")) {
+            for (const auto& [entry, data] : value["procedures"].items()) {
+                const auto& procedure = utility::json::procedure(data);
+                const auto& scan      = [&]() {
+                    return dll.find_procedure(procedure.get_name());
+                };
+
+                record(key, "procedures/" + entry, rva(scan()), time(scan));
+            }
+        }
+
+        if (value.contains("convars")) {
+            for (const auto& [entry, data] : value["convars"].items()) {
+                const auto& convar = utility::json::convar(data);
+                const auto& scan   = [&]() -> std::optional<ptr> {
+                    try {
+                        return dll.find_convar(convar.get_name(), convar.get_server_bounded());
+                    } catch (const std::runtime_error&) {
+                        return std::nullopt;
+                    }
+                };
+
+                record(key, "convars/" + entry, rva(scan()), time(scan));
+            }
+        }
+
+        if (value.contains("vtables")) {
+            // the index is timed once, as it's built once per module
+            std::optional<rtti::context> types = std::nullopt;
+
+            const auto build = time([&]() {
+                types.emplace(dll);
+            });
+            record(key, "vtables", std::nullopt, build);
+
+            for (const auto& [entry, data] : value["vtables"].items()) {
+                const auto& vtable = utility::json::vtable(data);
+                const auto& scan   = [&]() {
+                    return types->find_vtable(vtable.get_name(), vtable.get_offset());
+                };
+
+                record(key, "vtables/" + entry, rva(scan()), time(scan));
+            }
+        }
+
+        if (value.contains("interfaces")) {
+            std::optional<interfaces::context> registry = std::nullopt;
+
+            const auto walk = time([&]() {
+                registry.emplace(dll);
+            });
+            record(key, "interfaces", std::nullopt, walk);
+
+            for (const auto& [entry, data] : value["interfaces"].items()) {
+                const auto& registration = utility::json::registration(data);
+                const auto& scan         = [&]() -> std::optional<uintptr_t> {
+                    const auto found = registry->find_interface(registration.get_name());
+                    if (!found || (registration.get_instance() && !found->instance)) {
+                        return std::nullopt;
+                    }
+
+                    return registration.get_instance() ? found->instance : found->factory;
+                };
+
+                record(key, "interfaces/" + entry, scan(), time(scan));
+            }
+        }
+
+        if (value.contains("netvars")) {
+            // walked once per module, like the RTTI index. props are
+            // offsets, recorded the way the other entries' RVAs are
+            std::optional<netvars::context> graph = std::nullopt;
+
+            const auto walk = time([&]() {
+                graph.emplace(dll);
+            });
+            record(key, "netvars", std::nullopt, walk);
+
+            for (const auto& [entry, data] : value["netvars"].items()) {
+                const auto& netvar = utility::json::netvar(data);
+                const auto props   = graph->find_table(netvar.get_table());
+                if (!props || props->empty()) {
+                    record(key, "netvars/" + entry, std::nullopt, 0.0);
+                    continue;
+                }
 
-    // namespace/scope for the whole context
-    output.comment(config_name);
-    output.push_namespace("altdumper");
+                for (const auto& [name, offset] : *props) {
+                    record(key, "netvars/" + entry + '/' + std::string {name}, offset, 0.0);
+                }
+            }
+        }
+    }
+
+    if (golden_name.empty()) {
+        const auto& path = config_name + ".golden.json";
+
+        std::ofstream output(path);
+        output << std::setw(4) << current << '\n';
+
+        std::cout << "Golden file written to " << path << '\n';
+    }
 
-    // values will all be addresses, and we want them to be printed
-    // in hexadecimal, for ease
-    // TODO: consider making the spew JSON? so it's inherently more
-    // universal than the code-gen allows for
-    std::cout << std::hex;
-    for (const auto& [dll, entries] : addresses) {
-        // serialize name
-        auto begin             = dll.rfind("\\") + 1;
-        auto&& serialized_name = dll.substr(begin);
-        auto end               = serialized_name.rfind(".");
-        serialized_name        = serialized_name.substr(0, end);
+    std::cout << (failures ? "[!] " : "[+] ") << failures << " failure(s)" << std::endl;
+    return failures ? results::mismatched : EXIT_SUCCESS;
+}
 
-        // start namespace/scope with dll name with no extensions, comment
-        // full path right before
-        output.comment(dll);
-        output.push_namespace(serialized_name);
+[[nodiscard]] int strings() {
+    std::cout << "Provide module:\n";
+    auto&& module_name = utility::winapi::get_file_from_prompt();
 
-        std::cout << "[+] " << dll << " (" << serialized_name << ")\n";
+    const auto module = dump::open_module(module_name);
+    auto& dll         = *module;
 
-        for (const auto& [entry, value] : entries) {
-            output.push_value(entry, value);
-            std::cout << "[-]\t" << entry << '=' << value << '\n';
+    // every string of the data sections, by address
+    std::vector<std::tuple<uint32_t, std::string_view, std::string_view>> rows = {};
+    for (const auto& section : {".rdata", ".data"}) {
+        if (!dll.get_sections().contains(section)) {
+            continue;
         }
 
-        // pop dll namespace/scope
-        output.pop_scope();
+        for (const auto& [string, addresses] : dll.get_strings(section)) {
+            for (auto address : addresses) {
+                rows.emplace_back(address, section, string);
+            }
+        }
     }
 
-    output.pop_scope();
+    std::ranges::sort(rows);
+
+    std::cout << "You'll be prompted to provide a folder where the string list will be saved:\n";
+    auto&& path = utility::winapi::get_folder_from_prompt();
+
+    // serialize name, as make does
+    auto&& serialized_name = module_name.substr(module_name.rfind("\\") + 1);
+    serialized_name        = serialized_name.substr(0, serialized_name.rfind("."));
+
+    // one per line, relative address, section and the string, escaped
+    std::ofstream output(path + serialized_name + ".strings.txt");
+    output << std::hex;
+    for (const auto& [address, section, string] : rows) {
+        output << "0x" << address << '\t' << section << '\t';
+        for (auto c : string) {
+            switch (c) {
+                case '\t': {
+                    output << "\\t";
+                } break;
+                case '\n': {
+                    output << "\\n";
+                } break;
+                case '\r': {
+                    output << "\\r";
+                } break;
+                case '\\': {
+                    output << "\\\\";
+                } break;
+                default: {
+                    output << c;
+                } break;
+            }
+        }
 
-    // pop whole context namespace/scope
+        output << '\n';
+    }
 
+    std::cout << rows.size() << " strings written to " << path << serialized_name << ".strings.txt" << std::endl;
     return EXIT_SUCCESS;
 }
 }  // namespace functions
@@ -839,6 +2894,18 @@ here:
         case indices::make: {
             return functions::make();
         } break;
+        case indices::verify: {
+            return functions::verify();
+        } break;
+        case indices::strings: {
+            return functions::strings();
+        } break;
+        case indices::watch: {
+            return functions::watch();
+        } break;
+        case indices::shard: {
+            return functions::shard();
+        } break;
     }
 
     return EXIT_FAILURE;
@@ -850,8 +2917,24 @@ here:
  * 
  * @return int Result
  */
-int main() {
+int main(int argc, char** argv) {
     try {
+        for (auto i = 1; i < argc; ++i) {
+            if (std::string_view {argv[i]} == "--explain") {
+                arguments::explain = true;
+                arguments::forwarded += "--explain ";
+            } else if ((std::string_view {argv[i]} == "--dump") && ((i + 1) < argc)) {
+                // modules of configs are found in it by file name
+                arguments::captured.emplace(argv[++i]);
+                arguments::forwarded += "--dump \"" + std::string {argv[i]} + "\" ";
+            } else if ((std::string_view {argv[i]} == "--worker") && ((i + 2) < argc)) {
+                // started by shard, everything else is sent through the pipes it handed down
+                const auto in  = (HANDLE)(uintptr_t)std::stoull(argv[i + 1]);
+                const auto out = (HANDLE)(uintptr_t)std::stoull(argv[i + 2]);
+                return functions::serve(in, out);
+            }
+        }
+
     here:
         // entry dialogue
         std::cout
@@ -863,7 +2946,19 @@ int main() {
             << " (Generate JSON entry)"
                "\n- make: "
             << indices::make
-            << " (Spew addresses, prompt code generation)\n";
+            << " (Spew addresses, prompt code generation)"
+               "\n- verify: "
+            << indices::verify
+            << " (Check scan engines agree, diff results and timings against a golden run)"
+               "\n- strings: "
+            << indices::strings
+            << " (List every string of a module's data sections)"
+               "\n- watch: "
+            << indices::watch
+            << " (Make again whenever modules change on disk, until stopped)"
+               "\n- shard: "
+            << indices::shard
+            << " (Make every config in a folder, across worker processes)\n";
 
         // process
         int indice = EXIT_FAILURE;
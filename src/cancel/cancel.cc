@@ -0,0 +1,65 @@
+/**
+ * @file cancel.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Cooperative cancellation and work budgets
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "cancel.hh"
+// ===========================================
+
+// ===========================================
+using namespace cancel;
+std::string_view cancel::describe(reason why) {
+    switch (why) {
+        case reason::cancelled:
+            return "cancelled";
+        case reason::timed_out:
+            return "timed out";
+        case reason::exhausted:
+            return "byte budget exhausted";
+        default:
+            return "running";
+    }
+}
+
+context::context(context* parent, double seconds, uint64_t bytes)
+    : _parent(parent)
+    , _bytes(bytes) {
+    if (seconds > 0) {
+        _deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+    }
+}
+
+void context::stop(reason why) {
+    auto expected = reason::none;
+    _reason.compare_exchange_strong(expected, why);
+}
+
+bool context::charge(uint64_t bytes) {
+    const auto used = _used.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    if (_bytes && used > _bytes) {
+        stop(reason::exhausted);
+    } else if ((_deadline != std::chrono::steady_clock::time_point {}) && (std::chrono::steady_clock::now() >= _deadline)) {
+        stop(reason::timed_out);
+    }
+
+    // parents are charged either way, they account for all that's nested
+    const auto running = !_parent || _parent->charge(bytes);
+    return running && (_reason == reason::none);
+}
+
+reason context::get_reason() const {
+    if (const auto why = _reason.load(); why != reason::none) {
+        return why;
+    }
+
+    return _parent ? _parent->get_reason() : reason::none;
+}
+// ===========================================
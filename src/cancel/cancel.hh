@@ -0,0 +1,120 @@
+#pragma once
+
+// ===========================================
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains cooperative cancellation structs
+ * restrained to context
+ * 
+ */
+namespace cancel {
+//
+// ENUMS
+//
+
+enum reason : uint8_t {
+    none,
+    cancelled,
+    timed_out,
+    exhausted
+};
+
+/**
+ * @brief Get what a reason reads as in output
+ * 
+ * @param why Reason
+ * @return std::string_view Description
+ */
+[[nodiscard]] std::string_view describe(reason why);
+
+/**
+ * @brief A scope work runs under, with time and bytes scanned allowed
+ * to it. Scanners charge it as they go, at chunk granularity, and stop
+ * once it, or any scope it's nested in, is stopped
+ * 
+ * Charging is thread-safe, so a scope can be shared by workers
+ * 
+ */
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object, its time starting now
+     * 
+     * @param parent Scope nested in, has to outlive this one. nullptr for none
+     * @param seconds Time allowed, 0 being unlimited
+     * @param bytes Bytes allowed to be scanned, 0 being unlimited
+     */
+    [[nodiscard]] context(context* parent, double seconds, uint64_t bytes);
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Stop scope, keeping the first reason given
+     * 
+     * @param why Reason
+     */
+    void stop(reason why);
+
+    //
+    // DATA
+    //
+
+    context* _parent = nullptr;
+
+    // unset for no deadline
+    std::chrono::steady_clock::time_point _deadline = {};
+
+    uint64_t _bytes             = 0;
+    std::atomic<uint64_t> _used = 0;
+
+    std::atomic<reason> _reason = reason::none;
+
+  public:
+    //
+    // UTILITY
+    //
+
+    /**
+     * @brief Stop scope and everything nested in it
+     * 
+     */
+    inline auto request() {
+        stop(reason::cancelled);
+    }
+
+    /**
+     * @brief Account bytes about to be scanned, to scope and those it's nested in
+     * 
+     * @param bytes Bytes
+     * @return true Work may go on
+     * @return false Scope is stopped
+     */
+    [[nodiscard]] bool charge(uint64_t bytes);
+
+    /**
+     * @brief Get why scope is stopped, its own reason before its parents'
+     * 
+     * @return reason Reason, none while running
+     */
+    [[nodiscard]] reason get_reason() const;
+
+    [[nodiscard]] inline auto is_stopped() const {
+        return get_reason() != reason::none;
+    }
+};
+}  // namespace cancel
+// ===========================================
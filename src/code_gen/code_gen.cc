@@ -11,18 +11,66 @@
 
 // ===========================================
 #include "code_gen.hh"
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <stdexcept>
+#include <exception>
 // ===========================================
 
 // ===========================================
 using namespace code_gen;
 context::context(const std::string& path)
     : _path(path)
-    , _file(_path) {
+    , _exceptions(std::uncaught_exceptions()) {
     // Beginning of header
     _file << "#pragma once\n";
 }
 
 context::~context() {
-    _file.close();
+    // nothing's left to tell of a failed write by now. and a
+    // file unwound out of is left as it was, not half replaced
+    if (!_saved && (std::uncaught_exceptions() <= _exceptions)) {
+        try {
+            save();
+        } catch (const std::exception&) {
+        }
+    }
+}
+
+bool context::save() {
+    _saved = true;
+
+    const auto contents = _file.str();
+
+    // a file left as it was keeps its timestamp, so nothing including it rebuilds
+    if (std::ifstream existing(_path, std::ios::binary); existing) {
+        const std::string current(std::istreambuf_iterator<char>(existing), {});
+        if (current == contents) {
+            return false;
+        }
+    }
+
+    const auto temporary = _path + ".tmp";
+
+    auto written = false;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file << contents;
+        written = file.good();
+    }
+
+    std::error_code error = {};
+    if (written) {
+        std::filesystem::rename(temporary, _path, error);
+    }
+
+    // what's there is left as it was, rather than half replaced
+    if (!written || error) {
+        std::filesystem::remove(temporary, error);
+        throw std::runtime_error("Failed writing " + _path);
+    }
+
+    return true;
 }
 // ===========================================
@@ -2,7 +2,7 @@
 
 // ===========================================
 #include <string>
-#include <fstream>
+#include <sstream>
 #include <utility>
 #include <vector>
 // ===========================================
@@ -61,7 +61,8 @@ namespace detail {
 using indentation = detail::basic_indentation<detail::indent_style::TABS>;
 
 /**
-* @brief Represents a file
+* @brief Represents a file. It's generated in memory and only written when
+* it differs from what's on disk, so builds including it aren't redone
 * 
 */
 struct context {
@@ -81,7 +82,8 @@ struct context {
     /**
      * @brief Destroy the context object
      * 
-     * Closes file
+     * Saves file, if it wasn't already, unless it's being destroyed by an
+     * exception. What's been generated by then is only part of it
      * 
      */
     ~context();
@@ -91,9 +93,13 @@ struct context {
     // DATA
     //
 
-    std::string _path   = {};
-    std::ofstream _file = {};
-    size_t _scopes      = 0;
+    std::string _path        = {};
+    std::ostringstream _file = {};
+    size_t _scopes           = 0;
+    bool _saved              = false;
+
+    // exceptions in flight when constructed, more by destruction is unwinding
+    int _exceptions = 0;
 
   public:
     //
@@ -108,6 +114,16 @@ struct context {
         return _file;
     }
 
+    /**
+     * @brief Write file, unless it's already there with the same contents.
+     * It's written next to path, then moved over it, so nothing reading it
+     * ever sees half of it. Throws if it couldn't be, leaving it as it was
+     * 
+     * @return true File was written
+     * @return false File was unchanged
+     */
+    bool save();
+
     constexpr auto indent(size_t n) {
         for (auto i = 0; i < n; ++i) {
             _file << indentation::value;
@@ -129,6 +145,11 @@ struct context {
         _file << "// " << entry << '\n';
     }
 
+    inline auto include(const std::string& path) {
+        indent();
+        _file << "#include \"" << path << "\"\n";
+    }
+
     /**
      * @brief List a value to the stream with pretty-fication given
      * conditions and respect to indentation
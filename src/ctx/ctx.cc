@@ -15,32 +15,139 @@
 #include <algorithm>
 #include <utility>
 #include <array>
+#include <bit>
+#include <cstring>
+#include <cctype>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <future>
 // ===========================================
 
 // ===========================================
+namespace modules {
 namespace detail {
-constexpr uint16_t byte_swap_16bit(uint16_t bytes) {
-    return (uint16_t)(bytes << 8) | (uint16_t)(bytes >> 8);
+template<typename T>
+inline T load(const uint8_t* at) {
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
 }
 
-constexpr auto to_array_32bit(uint32_t bytes) {
-    return std::array<uint8_t, 4> {(uint8_t)((uint32_t)(bytes & 0xff000000) >> 24), (uint8_t)((uint32_t)(bytes & 0x00ff0000) >> 16), (uint8_t)((uint32_t)(bytes & 0x0000ff00) >> 8), (uint8_t)((uint32_t)(bytes & 0x000000ff))};
-}
+// names read out of images are symbol-like, anything longer isn't one
+constexpr size_t max_name = 0x100;
+
+// bytes scanned between cancellation checks
+constexpr size_t cancel_chunk = 0x10000;
+
+// positions handled per reference block, one bit each
+constexpr size_t reference_block = 64;
+
+/**
+ * Branch-free, so the compiler vectorizes it. Bit k is set when the 32-bit
+ * value at k, plus k * stride, equals value. Stride 0 matches absolute
+ * addresses, stride 1 matches displacements relative to their own position
+ */
+template<uint32_t stride>
+inline uint64_t match_references(const uint8_t* at, size_t count, uint32_t value) {
+    uint64_t mask = 0;
+    for (size_t k = 0; k < count; ++k) {
+        mask |= (uint64_t)((uint32_t)(load<uint32_t>(at + k) + (uint32_t)k * stride) == value) << k;
+    }
 
-constexpr auto endianness_swap_32bit(uint32_t bytes) {
-    return 0x10000 * ((uint32_t)(byte_swap_16bit((uint16_t)((bytes & 0x0000ffff))))) + (uint32_t)(byte_swap_16bit((uint16_t)((uint32_t)((bytes & 0xffff0000)) >> 16)));
+    return mask;
 }
 
-template<typename Y, typename X, size_t N, template<typename, size_t> typename A, size_t... Is>
-constexpr A<Y, N> cast_array_impl(const A<X, N>& a, std::index_sequence<Is...>) {
-    return {std::get<Is>(a)...};
+inline auto align_up(uintptr_t value, uintptr_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
 }
 
-template<typename Y, typename X, size_t N, template<typename, size_t> typename A, typename Indices = std::make_index_sequence<N>>
-constexpr A<Y, N> cast_array(const A<X, N>& a) {
-    return cast_array_impl<Y>(a, Indices {});
+constexpr uintptr_t page_size = 0x1000;
+
+// strings shorter than this are mostly bytes of something else
+constexpr size_t min_string = 4;
+
+// bytes around a streamed reference convar scanning walks through
+constexpr uintptr_t convar_reach = 0x100;
+
+/**
+ * Read exactly size bytes at offset, whole or nothing
+ */
+inline auto read_at(HANDLE file, uint64_t offset, void* out, size_t size) {
+    return io::read(file, offset, out, size) == size;
 }
+
+/**
+ * XXH64, fed whole stripes through update() and the tail through finish()
+ */
+struct content_hash {
+    constexpr static uint64_t primes[] = {0x9E3779B185EBCA87, 0xC2B2AE3D27D4EB4F, 0x165667B19E3779F9, 0x85EBCA77C2B2AE63, 0x27D4EB2F165667C5};
+    constexpr static size_t stripe    = 32;
+
+    uint64_t lanes[4] = {primes[0] + primes[1], primes[1], 0, 0 - primes[0]};
+    uint64_t length   = 0;
+
+    constexpr static uint64_t round(uint64_t lane, uint64_t input) {
+        return std::rotl(lane + (input * primes[1]), 31) * primes[0];
+    }
+
+    constexpr static uint64_t merge(uint64_t hash, uint64_t lane) {
+        return ((hash ^ round(0, lane)) * primes[0]) + primes[3];
+    }
+
+    inline void update(const uint8_t* at, size_t size) {
+        for (auto end = at + size; at < end; at += stripe) {
+            for (auto i = 0; i < 4; ++i) {
+                lanes[i] = round(lanes[i], load<uint64_t>(at + (i * sizeof(uint64_t))));
+            }
+        }
+
+        length += size;
+    }
+
+    inline uint64_t finish(const uint8_t* at, size_t size) {
+        // whole stripes of the tail still go through the lanes
+        if (const auto whole = size - (size % stripe); whole) {
+            update(at, whole);
+            at += whole;
+            size -= whole;
+        }
+
+        uint64_t hash = primes[4];
+        if (length) {
+            hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+            for (auto lane : lanes) {
+                hash = merge(hash, lane);
+            }
+        }
+
+        hash += length + size;
+
+        auto end = at + size;
+        for (; (at + sizeof(uint64_t)) <= end; at += sizeof(uint64_t)) {
+            hash = (std::rotl(hash ^ round(0, load<uint64_t>(at)), 27) * primes[0]) + primes[3];
+        }
+
+        if ((at + sizeof(uint32_t)) <= end) {
+            hash = (std::rotl(hash ^ (load<uint32_t>(at) * primes[0]), 23) * primes[1]) + primes[2];
+            at += sizeof(uint32_t);
+        }
+
+        for (; at < end; ++at) {
+            hash = std::rotl(hash ^ (*at * primes[4]), 11) * primes[0];
+        }
+
+        hash ^= hash >> 33;
+        hash *= primes[1];
+        hash ^= hash >> 29;
+        hash *= primes[2];
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+};
 }  // namespace detail
+}  // namespace modules
 // Not particularly needed but I'd like the exception namings to be accurate, so they get syntactically checked
 #define stringify(x) #x
 
@@ -50,14 +157,115 @@ context::context(const HMODULE& module) {
 }
 
 context::context(const std::string& path) {
-    if (auto module = LoadLibraryExA(path.c_str(), nullptr, DONT_RESOLVE_DLL_REFERENCES); module) {
-        initialize(module);
-    } else {
+    // overlapped, so sections can be read by several threads at once
+    _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+    if (_file == INVALID_HANDLE_VALUE) {
         throw std::runtime_error("Failed loading " + path);
     }
+
+    // first page holds every header we need to know the image layout
+    std::array<uint8_t, 0x1000> page = {};
+    const auto read                  = io::read(_file, 0, page.data(), page.size()).value_or(0);
+    if (read < sizeof(IMAGE_DOS_HEADER)) {
+        CloseHandle(_file);
+        throw std::runtime_error("Failed reading " + path);
+    }
+
+    const auto dos_header = (PIMAGE_DOS_HEADER)page.data();
+    const auto nt_offset  = (size_t)dos_header->e_lfanew;
+    if ((dos_header->e_magic != IMAGE_DOS_SIGNATURE) || ((nt_offset + sizeof(IMAGE_NT_HEADERS64)) > read)) {
+        CloseHandle(_file);
+        throw std::runtime_error(path + " isn't a PE image.");
+    }
+
+    // SizeOfImage and SizeOfHeaders sit at the same offsets in PE32 and PE32+
+    const auto nt_headers = (PIMAGE_NT_HEADERS32)(page.data() + nt_offset);
+    const auto image_size = nt_headers->OptionalHeader.SizeOfImage;
+    const auto head_size  = std::min<size_t>(nt_headers->OptionalHeader.SizeOfHeaders, image_size);
+
+    // reserved whole even when sections are streamed, as everything is
+    // addressed by where it is in the image. only what's read is committed
+    _bytes = (bytes)VirtualAlloc(nullptr, image_size, MEM_RESERVE, PAGE_NOACCESS);
+    if (!_bytes) {
+        release();
+        throw std::runtime_error("Failed reserving address space for " + path);
+    }
+
+    if (!VirtualAlloc(_bytes, head_size, MEM_COMMIT, PAGE_READWRITE) || !detail::read_at(_file, 0, _bytes, head_size)) {
+        release();
+        throw std::runtime_error("Failed mapping headers of " + path);
+    }
+
+    // destructor doesn't run for a throwing constructor
+    try {
+        initialize((HMODULE)_bytes, false);
+    } catch (...) {
+        release();
+        throw;
+    }
 }
 
-void context::initialize(const HMODULE& module) {
+context::context(const snapshot::context& captured, std::string_view name) {
+    const auto* image = captured.find_image(name);
+    if (!image) {
+        throw std::runtime_error("No image named " + std::string {name} + " in snapshot.");
+    }
+
+    // never written to, so the read-only mapping does
+    _bytes = (bytes)captured.view(image->base, image->size);
+    if (!_bytes) {
+        _copy = (bytes)VirtualAlloc(nullptr, image->size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (!_copy) {
+            throw std::runtime_error("Failed copying " + std::string {name} + " out of snapshot.");
+        }
+
+        captured.copy(image->base, image->size, _copy);
+        _bytes = _copy;
+    }
+
+    // destructor doesn't run for a throwing constructor
+    try {
+        initialize((HMODULE)_bytes, false);
+    } catch (...) {
+        release();
+        throw;
+    }
+
+    // the process relocated it to where it loaded it, and scans can't
+    // run past what was captured, whatever the headers say
+    _image_base = image->base;
+    _size       = std::min(_size, image->size);
+
+    for (auto& [key, value] : _sections) {
+        value.size = std::min<uintptr_t>(value.size, _size - std::min<uintptr_t>(value.start, _size));
+    }
+}
+
+context::~context() {
+    release();
+}
+
+void context::release() {
+    if (_copy) {
+        VirtualFree(_copy, 0, MEM_RELEASE);
+        _copy  = nullptr;
+        _bytes = nullptr;
+    }
+
+    if (_file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    if (_bytes) {
+        VirtualFree(_bytes, 0, MEM_RELEASE);
+        _bytes = nullptr;
+    }
+
+    CloseHandle(_file);
+    _file = INVALID_HANDLE_VALUE;
+}
+
+void context::initialize(const HMODULE& module, bool relocated) {
     _bytes = (bytes)module;
     if (!_bytes) {
         throw std::runtime_error(stringify(_bytes) " is null.");
@@ -68,23 +276,55 @@ void context::initialize(const HMODULE& module) {
         throw std::runtime_error(stringify(_dos_header) " is null.");
     }
 
-    _nt_headers = (PIMAGE_NT_HEADERS)((uintptr_t)_bytes + (uintptr_t)_dos_header->e_lfanew);
+    if (_dos_header->e_magic != IMAGE_DOS_SIGNATURE) {
+        throw std::runtime_error(stringify(_dos_header) " has no DOS signature.");
+    }
+
+    _nt_headers = (PIMAGE_NT_HEADERS32)((uintptr_t)_bytes + (uintptr_t)_dos_header->e_lfanew);
     if (!_nt_headers) {
         throw std::runtime_error(stringify(_nt_headers) " is null.");
     }
 
-    _size = _nt_headers->OptionalHeader.SizeOfImage;
+    // optional header magic is laid out the same for PE32 and PE32+,
+    // everything past it depends on the pointer width
+    switch (_nt_headers->OptionalHeader.Magic) {
+        case detail::image_traits<uint32_t>::magic: {
+            _architecture = architecture::x86;
+        } break;
+        case detail::image_traits<uint64_t>::magic: {
+            _architecture = architecture::x64;
+        } break;
+        default: {
+            throw std::runtime_error(stringify(_nt_headers) " has an unknown optional header.");
+        }
+    }
+
+    visit_width([&]<typename W>(W) {
+        const auto* headers = get_nt_headers<W>();
+
+        _size       = headers->OptionalHeader.SizeOfImage;
+        _image_base = relocated ? (uint64_t)(uintptr_t)_bytes : (uint64_t)headers->OptionalHeader.ImageBase;
+    });
+
     if (_size <= 0) {
-        throw std::runtime_error(stringify(_size) " is <= 0. Perhaps wrong arch binary?");
+        throw std::runtime_error(stringify(_size) " is <= 0.");
     }
 
     auto section_count = _nt_headers->FileHeader.NumberOfSections;
     _sections.reserve(section_count);
 
+    // file header is common to both layouts, so is the section list placement
     auto section_list = IMAGE_FIRST_SECTION(_nt_headers);
     for (auto i = 0; i < section_count; ++i) {
-        const char* name              = (const char*)section_list->Name;
-        _sections[std::string {name}] = section {name, section_list->PointerToRawData, section_list->SizeOfRawData};
+        // image is mapped, so sections sit at their virtual address and span
+        // their virtual size, zero filled past their raw data as the loader
+        // leaves them. names aren't null terminated when they take all 8 characters
+        const char* name = (const char*)section_list->Name;
+        auto size        = section_list->Misc.VirtualSize ? section_list->Misc.VirtualSize : section_list->SizeOfRawData;
+        size             = std::min<uintptr_t>(size, _size - std::min<uintptr_t>(section_list->VirtualAddress, _size));
+
+        auto&& key     = std::string {name, strnlen(name, IMAGE_SIZEOF_SHORT_NAME)};
+        _sections[key] = section {name, section_list->VirtualAddress, size, section_list->PointerToRawData, section_list->SizeOfRawData};
         ++section_list;
     }
 
@@ -93,55 +333,954 @@ void context::initialize(const HMODULE& module) {
     }
 }
 
-std::optional<ptr> context::find_signature(const int* bytes, size_t size, const std::string& section, size_t nth_match) const {
-    size_t match = 0;
+void context::page_in(std::string_view name) const {
+    if (is_resident(name)) {
+        return;
+    }
+
+    for (const auto& extent : commit(name)) {
+        if (!detail::read_at(extent.file, extent.offset, extent.out, extent.size)) {
+            throw std::runtime_error("Failed reading " + std::string {name});
+        }
+    }
 
-    uintptr_t start = 0;
-    uintptr_t end   = _size;
+    set_resident(name);
+}
+
+std::vector<io::extent> context::commit(std::string_view name) const {
+    std::vector<io::extent> out = {};
+    if (is_resident(name)) {
+        return out;
+    }
+
+    if (!_sections.contains(name)) {
+        for (const auto& [key, value] : _sections) {
+            auto extents = commit(key);
+            out.insert(out.end(), extents.begin(), extents.end());
+        }
+
+        return out;
+    }
+
+    const auto& value = get_section(name);
+    if (value.size) {
+        if (!VirtualAlloc(&_bytes[value.start], detail::align_up(value.size, 0x1000), MEM_COMMIT, PAGE_READWRITE)) {
+            throw std::runtime_error("Failed committing " + std::string {name});
+        }
+
+        // past raw data, the section is zero filled as it would be when loaded
+        if (const auto raw = std::min(value.size, value.raw_size)) {
+            out.push_back({_file, value.raw_start, &_bytes[value.start], raw});
+        }
+    }
+
+    return out;
+}
+
+void context::set_resident(std::string_view name) const {
+    if (is_resident(name)) {
+        return;
+    }
+
+    if (!_sections.contains(name)) {
+        for (const auto& [key, value] : _sections) {
+            set_resident(key);
+        }
+
+        _resident.emplace(name);
+        return;
+    }
+
+    const auto& value    = get_section(name);
+    const auto committed = detail::align_up(value.size, 0x1000);
+
+    // pages streamed scans committed are part of the section now
+    _resident_size += committed;
+    _resident_size -= detail::page_size * std::erase_if(_pages, [&](uintptr_t page) {
+        return (page >= value.start) && (page < (value.start + committed));
+    });
+
+    _resident.emplace(name);
+}
+
+void context::page_in(uintptr_t rva, size_t size) const {
+    // what isn't headers or a section's pages is never committed, reading
+    // it would fault rather than throw
+    if (_file != INVALID_HANDLE_VALUE) {
+        const auto headers = detail::align_up(_nt_headers->OptionalHeader.SizeOfHeaders, detail::page_size);
+
+        for (auto at = rva; at < (rva + size);) {
+            if (at < headers) {
+                at = headers;
+                continue;
+            }
+
+            const auto covering = std::ranges::find_if(_sections, [&](const auto& entry) {
+                const auto& value = entry.second;
+                return (at >= value.start) && (at < (value.start + detail::align_up(value.size, detail::page_size)));
+            });
+
+            if (covering == _sections.end()) {
+                throw std::runtime_error("Reading outside of any section.");
+            }
+
+            at = covering->second.start + detail::align_up(covering->second.size, detail::page_size);
+        }
+    }
+
+    for (const auto& [key, value] : _sections) {
+        // a section's last page is committed whole
+        const auto extent = detail::align_up(value.size, detail::page_size);
+        if ((rva >= (value.start + extent)) || ((rva + size) <= value.start)) {
+            continue;
+        }
+
+        if (!is_streamed(key)) {
+            page_in(key);
+            continue;
+        }
+
+        // pages are read whole, zero filled past the section's raw data
+        const auto raw   = std::min(value.size, value.raw_size);
+        const auto first = (std::max(rva, value.start) - value.start) & ~(detail::page_size - 1);
+        const auto end   = std::min(rva + size, value.start + extent) - value.start;
+
+        for (auto offset = first; offset < end; offset += detail::page_size) {
+            const auto page = value.start + offset;
+            if (_pages.contains(page)) {
+                continue;
+            }
+
+            if (!VirtualAlloc(&_bytes[page], detail::page_size, MEM_COMMIT, PAGE_READWRITE)) {
+                throw std::runtime_error("Failed committing page of " + key);
+            }
+
+            if ((offset < raw) && !detail::read_at(_file, value.raw_start + offset, &_bytes[page], std::min(detail::page_size, raw - offset))) {
+                throw std::runtime_error("Failed reading page of " + key);
+            }
+
+            _pages.insert(page);
+            _resident_size += detail::page_size;
+        }
+    }
+}
+
+void context::page_out() const {
+    if (_file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    for (const auto& name : _resident) {
+        if (!_sections.contains(name)) {
+            continue;
+        }
+
+        const auto& value = get_section(name);
+        if (value.size) {
+            VirtualFree(&_bytes[value.start], detail::align_up(value.size, 0x1000), MEM_DECOMMIT);
+        }
+    }
+
+    for (const auto page : _pages) {
+        VirtualFree(&_bytes[page], detail::page_size, MEM_DECOMMIT);
+    }
+
+    // tables view into what's been given back
+    _strings.clear();
+    _pooled.clear();
+
+    _resident.clear();
+    _pages.clear();
+    _resident_size = 0;
+}
+
+bool context::is_streamed(std::string_view section) const {
+    return _window && (_file != INVALID_HANDLE_VALUE) && _sections.contains(section) && !_resident.contains(section) && (get_section(section).size > _window);
+}
+
+template<typename F>
+void context::stream(std::string_view section, size_t overlap, F&& functor) const {
+    const auto& value = get_section(section);
+    const auto raw    = std::min(value.size, value.raw_size);
+
+    // one window is read into while the other is worked on, so
+    // reading and scanning overlap and at most two are held
+    std::array<std::vector<uint8_t>, 2> buffers = {};
+    for (auto& buffer : buffers) {
+        buffer.resize(_window + overlap);
+    }
+
+    const auto read = [&, section](uintptr_t offset, std::vector<uint8_t>& buffer) {
+        const auto size = std::min<uintptr_t>(_window + overlap, value.size - offset);
+        const auto file = (offset < raw) ? std::min(size, raw - offset) : 0;
+
+        std::fill(buffer.begin() + file, buffer.begin() + size, 0);
+        if (file && !detail::read_at(_file, value.raw_start + offset, buffer.data(), file)) {
+            throw std::runtime_error("Failed reading " + std::string {section});
+        }
+
+        return size;
+    };
+
+    auto pending = std::async(std::launch::async, read, 0, std::ref(buffers[0]));
+    for (uintptr_t offset = 0, current = 0; offset < value.size; offset += _window, current ^= 1) {
+        const auto size = pending.get();
+
+        if ((offset + _window) < value.size) {
+            pending = std::async(std::launch::async, read, offset + _window, std::ref(buffers[current ^ 1]));
+        }
+
+        // a pending read is waited on as it goes out of scope
+        if (!functor((const uint8_t*)buffers[current].data(), std::min<size_t>(_window, size), size, value.start + offset)) {
+            return;
+        }
+    }
+}
+
+uint64_t context::get_hash() const {
+    if (_hash.has_value()) {
+        return _hash.value();
+    }
+
+    detail::content_hash hash = {};
+
+    if (_file == INVALID_HANDLE_VALUE) {
+        _hash = hash.finish(_bytes, _size);
+        return _hash.value();
+    }
+
+    // chunk is a whole number of stripes, so only the last read has a tail
+    std::vector<uint8_t> chunk(0x100000);
+
+    for (uint64_t offset = 0;; offset += chunk.size()) {
+        const auto read = io::read(_file, offset, chunk.data(), chunk.size());
+        if (!read.has_value()) {
+            throw std::runtime_error("Failed hashing module.");
+        }
+
+        if (read.value() < chunk.size()) {
+            _hash = hash.finish(chunk.data(), read.value());
+            return _hash.value();
+        }
+
+        hash.update(chunk.data(), read.value());
+    }
+}
+
+std::pair<uintptr_t, uintptr_t> context::get_bounds(std::string_view section) const {
+    page_in(section);
 
     if (_sections.contains(section)) {
         const auto& value = get_section(section);
-        start             = value.start;
-        end               = value.size;
+        return {value.start, value.size};
+    }
+
+    return {0, _size};
+}
+
+const filter::context& context::get_filter(std::string_view section) const {
+    if (auto it = _filters.find(section); it != _filters.end()) {
+        return it->second;
+    }
+
+    const auto size = _sections.contains(section) ? get_section(section).size : _size;
+
+    std::filesystem::path path = {};
+    if (!_filter_cache.empty()) {
+        // section names aren't always file name safe
+        std::stringstream name = {};
+        name << std::hex << std::setw(16) << std::setfill('0') << get_hash() << '-';
+        std::ranges::copy_if(section, std::ostream_iterator<char>(name), [](char c) {
+            return std::isalnum((unsigned char)c);
+        });
+        name << ".qgram";
+
+        path = _filter_cache / name.str();
+        if (auto loaded = filter::context::load(path, size); loaded.has_value()) {
+            metrics::add(metrics::id::cache_hits, "filter");
+            return _filters.emplace(std::string {section}, std::move(loaded.value())).first->second;
+        }
+
+        metrics::add(metrics::id::cache_misses, "filter");
+    }
+
+    filter::context built = {};
+    if (is_streamed(section)) {
+        // windows overlap by a q-gram less a byte, so each is indexed once
+        built = filter::context(size);
+        stream(section, 2, [&](const uint8_t* window, size_t starts, size_t available, uintptr_t) {
+            built.add(window, std::min(available, starts + 2));
+            return true;
+        });
+    } else {
+        auto [start, bounded] = get_bounds(section);
+        built                 = filter::context(&_bytes[start], bounded);
+    }
+
+    const auto& out = _filters.emplace(std::string {section}, std::move(built)).first->second;
+
+    // a cache that can't be written to only costs the next run a rebuild
+    if (!path.empty()) {
+        out.save(path);
     }
 
-    end -= size;
+    return out;
+}
+
+const uint8_t* context::scan(const pattern::context& pattern, const uint8_t* first, size_t starts, size_t size, size_t nth_match, size_t& match, size_t& candidates) const {
+    if (!starts || (size < pattern.get_size())) {
+        return nullptr;
+    }
+
+    // last candidate is inclusive. matching reads whole words, past the
+    // pattern's end, so candidates too close to the block's end are
+    // matched byte by byte instead
+    const auto last = first + std::min(starts - 1, size - pattern.get_size());
+    const auto wide = (size >= pattern.get_width()) ? (first + (size - pattern.get_width())) : nullptr;
+
+    const auto matches = [&](const uint8_t* at) {
+        ++candidates;
+        return (wide && at <= wide) ? pattern.matches(at) : pattern.matches_bytewise(at);
+    };
+
+    switch (pattern.get_engine()) {
+        case pattern::context::engine::horspool: {
+            // every match holds the run at the same place, and Horspool never
+            // skips an occurrence of the run, so candidates stay in order
+            const auto [index, length] = pattern.get_run();
+            const auto run             = &pattern.get_value()[index];
+            const auto tail            = run[length - 1];
+
+            for (auto at = first + index; at <= (last + index);) {
+                const auto byte = at[length - 1];
+                if ((byte == tail) && !std::memcmp(at, run, length - 1)) {
+                    if (matches(at - index) && (match++ == nth_match)) {
+                        return at - index;
+                    }
+                }
 
-    for (auto i = start; i < (start + end); ++i) {
-        auto found = true;
-        for (auto j = 0; j < size; ++j) {
-            if (get_byte(i + j) != bytes[j] && bytes[j] != -1) {
-                found = false;
+                at += pattern.get_shift(byte);
+            }
+        } break;
+        case pattern::context::engine::anchored: {
+            const auto [index, byte] = pattern.get_anchor().value();
+
+            for (auto at = first; at <= last; ++at) {
+                at = (const uint8_t*)std::memchr(at + index, byte, (size_t)(last - at) + 1);
+                if (!at) {
+                    break;
+                }
+
+                at -= index;
+                if (matches(at) && (match++ == nth_match)) {
+                    return at;
+                }
+            }
+        } break;
+        case pattern::context::engine::shift_or: {
+            // a single register holds the whole state, one lookup
+            // per byte and never reads past the last candidate's end
+            const auto table = pattern.get_table(0);
+            const auto hit   = 1ull << (pattern.get_size() - 1);
+            const auto end   = last + pattern.get_size();
+
+            uint64_t state = ~0ull;
+            for (auto at = first; at < end; ++at) {
+                state = (state << 1) | table[*at];
+                if (state & hit) {
+                    continue;
+                }
+
+                ++candidates;
+                if (match++ == nth_match) {
+                    return at + 1 - pattern.get_size();
+                }
+            }
+        } break;
+        case pattern::context::engine::linear: {
+            for (auto at = first; at <= last; ++at) {
+                if (matches(at) && (match++ == nth_match)) {
+                    return at;
+                }
+            }
+        } break;
+    }
+
+    return nullptr;
+}
+
+const string_table& context::get_strings(std::string_view section) const {
+    if (auto it = _strings.find(section); it != _strings.end()) {
+        metrics::add(metrics::id::cache_hits, "strings");
+        return it->second;
+    }
+
+    metrics::add(metrics::id::cache_misses, "strings");
+
+    if (is_streamed(section)) {
+        return get_streamed_strings(section);
+    }
+
+    auto [start, size] = get_bounds(section);
+    const auto bytes   = (const char*)&_bytes[start];
+
+    // a string is whatever printable run a NUL ends
+    string_table out = {};
+    size_t begin     = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const auto c = (uint8_t)bytes[i];
+        if (!c) {
+            if ((i - begin) >= detail::min_string) {
+                out[std::string_view {&bytes[begin], i - begin}].push_back((uint32_t)(start + begin));
+            }
+
+            begin = i + 1;
+        } else if ((c < 0x20 || c > 0x7E) && c != '\t' && c != '\n' && c != '\r') {
+            begin = i + 1;
+        }
+    }
+
+    metrics::add(metrics::id::bytes_scanned, section, size);
+    return _strings.emplace(std::string {section}, std::move(out)).first->second;
+}
+
+const string_table& context::get_streamed_strings(std::string_view section) const {
+    // the run being read is appended as it goes, so one that spans windows
+    // doesn't need them both. what doesn't end up a string is cut back off
+    std::string pool                                        = {};
+    std::vector<std::tuple<size_t, size_t, uint32_t>> found = {};
+
+    size_t begin   = 0;
+    uintptr_t from = get_section(section).start;
+    size_t size    = 0;
+
+    stream(section, 0, [&](const uint8_t* window, size_t positions, size_t, uintptr_t rva) {
+        for (size_t i = 0; i < positions; ++i) {
+            const auto c = window[i];
+            if (!c) {
+                if ((pool.size() - begin) >= detail::min_string) {
+                    found.emplace_back(begin, pool.size() - begin, (uint32_t)from);
+                } else {
+                    pool.resize(begin);
+                }
+
+                begin = pool.size();
+                from  = rva + i + 1;
+            } else if ((c < 0x20 || c > 0x7E) && c != '\t' && c != '\n' && c != '\r') {
+                pool.resize(begin);
+                from = rva + i + 1;
+            } else {
+                pool += (char)c;
+            }
+        }
+
+        size += positions;
+        return true;
+    });
+
+    // an unterminated tail isn't a string
+    pool.resize(begin);
+
+    const auto& kept = (_pooled[std::string {section}] = std::move(pool));
+
+    string_table out = {};
+    for (const auto& [offset, length, rva] : found) {
+        out[std::string_view {&kept[offset], length}].push_back(rva);
+    }
+
+    metrics::add(metrics::id::bytes_scanned, section, size);
+    return _strings.emplace(std::string {section}, std::move(out)).first->second;
+}
+
+matches& context::get_matches(std::string_view key, uintptr_t start) const {
+    auto it = _match_lists.find(key);
+    if (it == _match_lists.end()) {
+        it = _match_lists.emplace(std::string {key}, matches {{}, start, false}).first;
+    }
+
+    return it->second;
+}
+
+const std::string& context::get_signature_key(const pattern::context& pattern, std::string_view section) const {
+    // everything a match depends on: where, and the pattern's bytes,
+    // mask and sets. the engine picked doesn't change matches
+    _match_key.assign(1, 's').append(section).push_back('\0');
+    _match_key.append((const char*)pattern.get_value().data(), pattern.get_size());
+    _match_key.append((const char*)pattern.get_mask().data(), pattern.get_size());
+    for (const auto& [index, bytes] : pattern.get_sets()) {
+        _match_key.append((const char*)&index, sizeof(index));
+        for (size_t word = 0; word < (bytes.size() / 64); ++word) {
+            const auto bits = ((bytes >> (word * 64)) & std::bitset<256>(~0ull)).to_ullong();
+            _match_key.append((const char*)&bits, sizeof(bits));
+        }
+    }
+
+    return _match_key;
+}
+
+template<typename W>
+const std::string& context::get_reference_key(uint32_t rva, std::string_view section) const {
+    _match_key.assign(1, std::is_same_v<W, uint64_t> ? 'q' : 'd').append(section).push_back('\0');
+    _match_key.append((const char*)&rva, sizeof(rva));
+    return _match_key;
+}
+
+template<typename F>
+std::optional<uintptr_t> context::find_nth(std::string_view key, size_t nth_match, uintptr_t start, F&& next) const {
+    auto& list = get_matches(key, start);
+    metrics::add((nth_match < list.found.size() || list.done) ? metrics::id::cache_hits : metrics::id::cache_misses, "matches");
+
+    while (nth_match >= list.found.size() && !list.done) {
+        const auto found = next(list.resume);
+        if (!found.has_value()) {
+            // a scan given up on is picked up again by the next call
+            list.done = !(_cancel && _cancel->is_stopped());
+            break;
+        }
+
+        list.found.push_back(found.value());
+        list.resume = found.value() + 1;
+    }
+
+    if (nth_match >= list.found.size()) {
+        return std::nullopt;
+    }
+
+    return list.found[nth_match];
+}
+
+std::vector<std::pair<pattern::context::engine, std::optional<ptr>>> context::find_signature_each(const pattern::context& pattern, std::string_view section, size_t nth_match) const {
+    std::vector<std::pair<pattern::context::engine, std::optional<ptr>>> out = {};
+
+    for (const auto which : pattern::engines) {
+        if (!pattern.supports(which)) {
+            continue;
+        }
+
+        auto forced = pattern;
+        forced.set_engine(which);
+
+        clear_matches();
+        out.emplace_back(which, find_signature(forced, section, nth_match));
+    }
+
+    clear_matches();
+    return out;
+}
+
+std::optional<ptr> context::find_signature(const pattern::context& pattern, std::string_view section, size_t nth_match) const {
+    size_t match      = 0;
+    size_t candidates = 0;
+
+    if (!pattern.get_size()) {
+        return std::nullopt;
+    }
+
+    // a cached filter spares paging in sections nothing matches in
+    if (!get_filter(section).admits(pattern)) {
+        metrics::add(metrics::id::rejected, section);
+        return std::nullopt;
+    }
+
+    // recorded once the scan is over, never from inside it
+    uint64_t scanned  = 0;
+    const auto report = [&]() {
+        metrics::add(metrics::id::bytes_scanned, section, scanned);
+        metrics::add(metrics::id::candidates, section, candidates);
+        metrics::add(metrics::id::matches, section, match);
+    };
+
+    if (is_streamed(section)) {
+        // windows overlap by the pattern less a byte, so every
+        // position is a candidate in exactly one of them
+        std::optional<uintptr_t> found = std::nullopt;
+        stream(section, pattern.get_size() - 1, [&](const uint8_t* window, size_t starts, size_t size, uintptr_t rva) {
+            if (!charge(starts)) {
+                return false;
+            }
+
+            const auto at = scan(pattern, window, starts, size, nth_match, match, candidates);
+            if (!at) {
+                scanned += starts;
+                return true;
+            }
+
+            scanned += (at - window) + pattern.get_size();
+            found = rva + (at - window);
+            return false;
+        });
+
+        report();
+        if (!found.has_value()) {
+            return std::nullopt;
+        }
+
+        page_in(found.value(), pattern.get_size());
+        return ptr(&_bytes[found.value()], get_rebase());
+    }
+
+    auto [start, size] = get_bounds(section);
+
+    // each call to next finds the match after the last one found,
+    // which is the match-th of the section. candidates are taken a chunk
+    // at a time, matches may still run into the next one
+    const auto found = find_nth(get_signature_key(pattern, section), nth_match, start, [&](uintptr_t resume) -> std::optional<uintptr_t> {
+        for (auto chunk = resume; chunk < (start + size); chunk += detail::cancel_chunk) {
+            const auto first  = (const uint8_t*)&_bytes[chunk];
+            const auto left   = size - (chunk - start);
+            const auto starts = std::min(left, detail::cancel_chunk);
+            if (!charge(starts)) {
                 break;
             }
+
+            const auto at = scan(pattern, first, starts, left, match, match, candidates);
+            if (at) {
+                scanned += (at - first) + pattern.get_size();
+                return chunk + (at - first);
+            }
+
+            scanned += starts;
+        }
+
+        return std::nullopt;
+    });
+
+    report();
+
+    if (!found.has_value()) {
+        return std::nullopt;
+    }
+
+    return ptr(&_bytes[found.value()], get_rebase());
+}
+
+void context::scan_signatures(std::span<const std::pair<const pattern::context*, size_t>> wanted, std::string_view section) const {
+    if (is_streamed(section)) {
+        return;
+    }
+
+    struct pending {
+        const pattern::context* pattern = nullptr;
+        size_t nth_match                = 0;
+        matches* list                   = nullptr;
+    };
+
+    auto [start, size] = get_bounds(section);
+    const auto end     = start + size;
+
+    // patterns whose lists are still short of the match wanted
+    std::vector<pending> scans = {};
+    for (const auto& [pattern, nth_match] : wanted) {
+        if (!pattern->get_size() || !get_filter(section).admits(*pattern)) {
+            continue;
         }
 
-        if (found) {
-            if (match != nth_match) {
+        auto& list = get_matches(get_signature_key(*pattern, section), start);
+        if (!list.done && nth_match >= list.found.size()) {
+            scans.push_back({pattern, nth_match, &list});
+        }
+    }
+
+    uint64_t scanned  = 0;
+    size_t match      = 0;
+    size_t candidates = 0;
+
+    for (auto chunk = start; (chunk < end) && !scans.empty(); chunk += detail::cancel_chunk) {
+        const auto chunk_end = std::min<uintptr_t>(end, chunk + detail::cancel_chunk);
+
+        for (auto it = scans.begin(); it != scans.end();) {
+            auto& [pattern, nth_match, list] = *it;
+            if (list->resume < chunk_end && !charge(chunk_end - list->resume)) {
+                // a scan given up on is picked up again by find_signature
+                scans.clear();
+                break;
+            }
+
+            // every match in the chunk, up to the one wanted, matches
+            // may run past its end
+            while (list->resume < chunk_end && nth_match >= list->found.size()) {
+                const auto first  = (const uint8_t*)&_bytes[list->resume];
+                const auto starts = chunk_end - list->resume;
+
+                size_t count  = 0;
+                const auto at = scan(*pattern, first, starts, end - list->resume, 0, count, candidates);
+                if (!at) {
+                    scanned += starts;
+                    list->resume = chunk_end;
+                    break;
+                }
+
+                scanned += (at - first) + 1;
                 ++match;
+
+                list->found.push_back(list->resume + (at - first));
+                list->resume = list->found.back() + 1;
+            }
+
+            list->done = list->resume >= end;
+            if (list->done || nth_match < list->found.size()) {
+                it = scans.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    metrics::add(metrics::id::bytes_scanned, section, scanned);
+    metrics::add(metrics::id::candidates, section, candidates);
+    metrics::add(metrics::id::matches, section, match);
+}
+
+std::pmr::vector<candidate> context::find_nearest(const pattern::context& pattern, std::string_view section, size_t mismatches, size_t limit, std::pmr::memory_resource* scratch) const {
+    std::pmr::vector<candidate> out(scratch);
+
+    auto [start, size] = get_bounds(section);
+    if (!pattern.get_size() || (size < pattern.get_size()) || !limit) {
+        return out;
+    }
+
+    const auto words = pattern.get_words();
+    const auto top   = (pattern.get_size() - 1) / 64;
+    const auto hit   = 1ull << ((pattern.get_size() - 1) % 64);
+
+    // row j is clear where a prefix of the pattern ends with at most j
+    // bytes wrong. a row takes the row above it, shifted, as the
+    // case where the current byte is one more wrong
+    std::pmr::vector<uint64_t> states((mismatches + 1) * words, ~0ull, scratch);
+    std::pmr::vector<uint64_t> above(words, 0, scratch);
+
+    // worst kept candidate on top, a later one never wins a tie
+    const auto worse = [](const candidate& left, const candidate& right) {
+        return std::pair {left.mismatches, left.address.get()} < std::pair {right.mismatches, right.address.get()};
+    };
+
+    const auto first = (const uint8_t*)&_bytes[start];
+    const auto end   = first + size;
+
+    auto at = first;
+    for (; at < end; ++at) {
+        if (!((at - first) % detail::cancel_chunk) && !charge(std::min<size_t>(detail::cancel_chunk, end - at))) {
+            break;
+        }
+
+        const auto mask = pattern.get_table(*at);
+
+        for (size_t j = 0; j <= mismatches; ++j) {
+            const auto row = &states[j * words];
+
+            uint64_t carry = 0;
+            for (size_t w = 0; w < words; ++w) {
+                const auto shifted = (row[w] << 1) | carry;
+                carry              = row[w] >> 63;
+
+                row[w]   = (shifted | mask[w]) & (j ? above[w] : ~0ull);
+                above[w] = shifted;
+            }
+        }
+
+        // rows only ever clear more bits going down, so
+        // the first clear one is the mismatch count
+        for (size_t j = 0; j <= mismatches; ++j) {
+            if (states[(j * words) + top] & hit) {
                 continue;
             }
 
-            return ptr(&_bytes[i]);
+            if (out.size() == limit) {
+                if (j >= out.front().mismatches) {
+                    break;
+                }
+
+                std::ranges::pop_heap(out, worse);
+                out.pop_back();
+            }
+
+            out.push_back({ptr(at + 1 - pattern.get_size(), get_rebase()), j});
+            std::ranges::push_heap(out, worse);
+            break;
+        }
+
+        // nothing left to improve on, past this byte
+        if ((out.size() == limit) && !out.front().mismatches) {
+            ++at;
+            break;
+        }
+    }
+
+    metrics::add(metrics::id::bytes_scanned, section, (uint64_t)(at - first));
+
+    std::ranges::sort_heap(out, worse);
+    return out;
+}
+
+template<typename W>
+std::optional<ptr> context::find_reference(const ptr& target, std::string_view section, size_t nth_match) const {
+    size_t match     = 0;
+    uint64_t scanned = 0;
+
+    const auto rva = (uint32_t)(target.get() - (uintptr_t)_bytes);
+
+    // candidate positions are the first starts of block, at relative
+    // address at, each read as a 32-bit value
+    const auto search = [&](const uint8_t* block, size_t starts, size_t size, uintptr_t at, size_t nth) -> std::optional<uintptr_t> {
+        if (size < sizeof(uint32_t)) {
+            return std::nullopt;
+        }
+
+        const auto positions = std::min(starts, size - sizeof(uint32_t) + 1);
+        for (size_t i = 0; i < positions; i += detail::reference_block) {
+            if (!(i % detail::cancel_chunk) && !charge(std::min(detail::cancel_chunk, positions - i))) {
+                scanned += i;
+                return std::nullopt;
+            }
+
+            const auto count = std::min<size_t>(detail::reference_block, positions - i);
+
+            uint64_t mask = 0;
+            if constexpr (std::is_same_v<W, uint64_t>) {
+                // disp32 at i targets i + 4 + disp32, so every position in the
+                // block compares against the same value once its index is added
+                mask = detail::match_references<1>(&block[i], count, rva - sizeof(uint32_t) - (uint32_t)(at + i));
+            } else {
+                mask = detail::match_references<0>(&block[i], count, (uint32_t)(_image_base + rva));
+            }
+
+            for (; mask; mask &= mask - 1) {
+                if (match++ == nth) {
+                    scanned += i + count;
+                    return at + i + std::countr_zero(mask);
+                }
+            }
         }
+
+        scanned += positions;
+        return std::nullopt;
+    };
+
+    std::optional<uintptr_t> found = std::nullopt;
+    if (is_streamed(section)) {
+        stream(section, sizeof(uint32_t) - 1, [&](const uint8_t* window, size_t starts, size_t size, uintptr_t at) {
+            found = search(window, starts, size, at, nth_match);
+            return !found.has_value();
+        });
+    } else {
+        auto [start, size] = get_bounds(section);
+
+        // find_string asks for one reference after the other, and
+        // every instance past the first picks up where the last stopped
+        found = find_nth(get_reference_key<W>(rva, section), nth_match, start, [&](uintptr_t resume) {
+            const auto left = size - (resume - start);
+            return search(&_bytes[resume], left, left, resume, match);
+        });
+    }
+
+    metrics::add(metrics::id::bytes_scanned, section, scanned);
+    metrics::add(metrics::id::matches, section, match);
+
+    if (!found.has_value()) {
+        return std::nullopt;
+    }
+
+    page_in(found.value(), sizeof(uint32_t));
+    return ptr(&_bytes[found.value()], get_rebase());
+}
+
+template std::optional<ptr> context::find_reference<uint32_t>(const ptr&, std::string_view, size_t) const;
+template std::optional<ptr> context::find_reference<uint64_t>(const ptr&, std::string_view, size_t) const;
+
+std::optional<uintptr_t> context::locate_string(std::string_view string, std::pmr::memory_resource* scratch) const {
+    const auto& table = get_strings(".rdata");
+    if (auto found = table.find(string); found != table.end()) {
+        return found->second.front();
+    }
+
+    // short ones, and ones only found as the tail of a longer string.
+    // null terminator included, so we don't land on a prefix
+    const pattern::context compiled(reinterpret_cast<const uint8_t*>(string.data()), string.size() + 1, scratch);
+    if (const auto found = find_signature(compiled, ".rdata", 0); found.has_value()) {
+        return found.value().get() - (uintptr_t)_bytes;
     }
 
     return std::nullopt;
 }
 
-std::optional<ptr> context::find_string(const char* bytes, size_t size, const std::string& section, size_t reference_instance) const {
-    // hacky solution . . . . . .
-    std::vector<int> casted = {};
-    casted.reserve(size + 1);
+template<typename W>
+void context::scan_references(std::span<const uint32_t> targets, std::string_view section) const {
+    auto [start, size] = get_bounds(section);
+    if (size < sizeof(uint32_t)) {
+        return;
+    }
+
+    std::vector<uint32_t> sorted(targets.begin(), targets.end());
+    std::ranges::sort(sorted);
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // per target, in the same order as sorted
+    std::vector<std::vector<uintptr_t>> found(sorted.size());
+
+    // every position computes what it would reference, and only what
+    // lands between the lowest and highest target is looked up
+    const auto low  = sorted.front();
+    const auto high = sorted.back();
+
+    const auto positions = size - sizeof(uint32_t) + 1;
+    for (size_t i = 0; i < positions; ++i) {
+        if (!(i % detail::cancel_chunk) && !charge(std::min(detail::cancel_chunk, positions - i))) {
+            // nothing's kept from a pass given up on
+            metrics::add(metrics::id::bytes_scanned, section, i);
+            return;
+        }
+
+        const auto value  = detail::load<uint32_t>(&_bytes[start + i]);
+        const auto target = std::is_same_v<W, uint64_t> ? (uint32_t)(value + (uint32_t)(start + i + sizeof(uint32_t))) : (uint32_t)(value - (uint32_t)_image_base);
+        if (target < low || target > high) {
+            continue;
+        }
+
+        if (const auto at = std::ranges::lower_bound(sorted, target); at != sorted.end() && *at == target) {
+            found[at - sorted.begin()].push_back(start + i);
+        }
+    }
+
+    // the whole section's been through, so the lists are complete
+    size_t match = 0;
+    for (size_t k = 0; k < sorted.size(); ++k) {
+        auto& list = get_matches(get_reference_key<W>(sorted[k], section), start);
+
+        match += found[k].size();
+        list   = matches {std::move(found[k]), start + size, true};
+    }
+
+    metrics::add(metrics::id::bytes_scanned, section, positions);
+    metrics::add(metrics::id::matches, section, match);
+}
+
+void context::scan_references(std::span<const std::string_view> strings, std::string_view section, std::pmr::memory_resource* scratch) const {
+    if (is_streamed(section)) {
+        return;
+    }
 
-    for (auto i = 0; i <= size; ++i) {
-        casted.push_back(bytes[i]);
+    std::vector<uint32_t> targets = {};
+    for (const auto& string : strings) {
+        if (const auto rva = locate_string(string, scratch); rva.has_value()) {
+            targets.push_back((uint32_t)rva.value());
+        }
     }
 
-    auto string_find = find_signature(casted.data(), casted.size(), ".rdata", 0);
+    if (targets.empty()) {
+        return;
+    }
+
+    visit_width([&]<typename W>(W) {
+        scan_references<W>(targets, section);
+    });
+}
+
+std::optional<ptr> context::find_string(std::string_view string, std::string_view section, size_t reference_instance, std::pmr::memory_resource* scratch) const {
+    const auto string_find = locate_string(string, scratch);
     if (string_find.has_value()) {
-        auto pattern = detail::cast_array<int>(detail::to_array_32bit(detail::endianness_swap_32bit(string_find.value().get())));
-        return find_signature(pattern.data(), pattern.size(), section, reference_instance);
+        return visit_width([&]<typename W>(W) {
+            return find_reference<W>(ptr(&_bytes[string_find.value()], get_rebase()), section, reference_instance);
+        });
     } else {
         throw std::runtime_error("Failed finding string in .rdata.");
     }
@@ -149,39 +1288,136 @@ std::optional<ptr> context::find_string(const char* bytes, size_t size, const st
     return std::nullopt;
 }
 
-std::optional<ptr> context::find_procedure(const std::string& name) const {
-    auto procedure = ptr(GetProcAddress((HMODULE)get_bytes(), name.c_str()));
-    if (procedure.valid()) {
-        return procedure;
+std::string_view context::read_name(uint64_t address) const {
+    if ((address < _image_base) || (address >= (_image_base + _size))) {
+        return {};
     }
 
-    return std::nullopt;
+    const auto rva  = (uintptr_t)(address - _image_base);
+    const auto size = std::min<size_t>(detail::max_name, _size - rva);
+    page_in(rva, size);
+
+    const auto name = std::string_view {(const char*)get_at(rva), size};
+    const auto end  = name.find('\0');
+    if (!end || end == std::string_view::npos) {
+        return {};
+    }
+
+    if (!std::all_of(name.begin(), name.begin() + end, [](char c) {
+            return std::isprint((unsigned char)c);
+        })) {
+        return {};
+    }
+
+    return name.substr(0, end);
 }
 
-std::optional<ptr> context::find_convar(const char* bytes, size_t size, bool server_bounded) const {
-    size_t count         = 0;
-    auto constructor_ref = find_string(bytes, size, ".text", count++);
+std::optional<ptr> context::find_procedure(std::string_view name) const {
+    // walked by hand rather than through GetProcAddress, as images
+    // mapped as a resource aren't known to the loader
+    const auto& directory = visit_width([&]<typename W>(W) {
+        return get_nt_headers<W>()->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    });
+
+    // everything the directory points at is trusted to nothing, a range
+    // that runs off the image has the export missing rather than fault
+    const auto fits = [&](uint64_t rva, uint64_t size) {
+        return (rva <= _size) && (size <= (_size - rva));
+    };
+
+    if (!directory.VirtualAddress || (directory.Size < sizeof(IMAGE_EXPORT_DIRECTORY)) || !fits(directory.VirtualAddress, directory.Size)) {
+        return std::nullopt;
+    }
+
+    page_in(directory.VirtualAddress, directory.Size);
 
-    if (constructor_ref.has_value()) {
-        int pad        = (server_bounded ? -6 : 4);
-        uint8_t opcode = (server_bounded ? 0x68 : 0xE8);
+    const auto exports = (PIMAGE_EXPORT_DIRECTORY)get_at(directory.VirtualAddress);
+    const auto count   = (uint64_t)exports->NumberOfNames;
+    if (!fits(exports->AddressOfNames, count * sizeof(DWORD)) || !fits(exports->AddressOfNameOrdinals, count * sizeof(WORD)) || !fits(exports->AddressOfFunctions, (uint64_t)exports->NumberOfFunctions * sizeof(DWORD))) {
+        return std::nullopt;
+    }
+
+    page_in(exports->AddressOfNames, count * sizeof(DWORD));
+    page_in(exports->AddressOfNameOrdinals, count * sizeof(WORD));
+    page_in(exports->AddressOfFunctions, exports->NumberOfFunctions * sizeof(DWORD));
 
-        while (constructor_ref.value().get_byte(pad) != opcode) {
-            constructor_ref = find_string(bytes, size, ".text", count++);
+    const auto names    = (const DWORD*)get_at(exports->AddressOfNames);
+    const auto ordinals = (const WORD*)get_at(exports->AddressOfNameOrdinals);
+    const auto entries  = (const DWORD*)get_at(exports->AddressOfFunctions);
+
+    for (uint64_t i = 0; i < count; ++i) {
+        // only as much of each name as could match is read, terminator included
+        const auto at = names[i];
+        if (!fits(at, name.size() + 1)) {
+            continue;
         }
 
-        auto bounded_found = constructor_ref.value().followed_until(0xC7, server_bounded ? ptr::direction::forward : ptr::direction::back);
-        auto final_found   = (server_bounded ? bounded_found : bounded_found.followed_until(0xB9, ptr::direction::forward));
+        page_in(at, name.size() + 1);
 
-        if (!final_found.valid()) {
+        const auto candidate = (const char*)get_at(at);
+        if ((std::memcmp(candidate, name.data(), name.size()) != 0) || candidate[name.size()]) {
+            continue;
+        }
+
+        if (ordinals[i] >= exports->NumberOfFunctions) {
             return std::nullopt;
         }
 
-        return final_found.padded(1 + (int)server_bounded);
-    } else {
-        throw std::runtime_error("Failed finding .text.");
+        // a forwarder is the name of another module's export, held in
+        // the directory, rather than code of this one
+        const auto entry = entries[ordinals[i]];
+        if ((entry >= directory.VirtualAddress) && (entry < (directory.VirtualAddress + directory.Size))) {
+            return std::nullopt;
+        }
+
+        if (entry >= _size) {
+            return std::nullopt;
+        }
+
+        return ptr(get_at(entry), get_rebase());
     }
 
     return std::nullopt;
 }
+
+std::optional<ptr> context::find_convar(std::string_view name, bool server_bounded, std::pmr::memory_resource* scratch) const {
+    // constructor call sequences below are x86 encodings
+    if (_architecture != architecture::x86) {
+        throw std::runtime_error("ConVar scanning is only supported on x86 images.");
+    }
+
+    const int pad        = (server_bounded ? -6 : 4);
+    const uint8_t opcode = (server_bounded ? 0x68 : 0xE8);
+
+    std::optional<ptr> constructor_ref = std::nullopt;
+    for (size_t count = 0;; ++count) {
+        // references ran out, or the scan was stopped, before one
+        // of them was a constructor call
+        constructor_ref = find_string(name, ".text", count, scratch);
+        if (!constructor_ref.has_value()) {
+            return std::nullopt;
+        }
+
+        // streamed .text only has the pages references land on, the
+        // constructor call around them is paged in before it's walked
+        const auto& text = get_section(".text");
+        const auto at    = constructor_ref.value().get() - (uintptr_t)_bytes;
+        const auto first = std::max(at - std::min(at, detail::convar_reach), text.start);
+        const auto last  = std::min(at + detail::convar_reach, text.start + text.size);
+        page_in(first, last - first);
+
+        if (constructor_ref.value().get_byte(pad) == opcode) {
+            break;
+        }
+    }
+
+    auto bounded_found = constructor_ref.value().followed_until(0xC7, server_bounded ? ptr::direction::forward : ptr::direction::back);
+    auto final_found   = (server_bounded ? bounded_found : bounded_found.followed_until(0xB9, ptr::direction::forward));
+
+    if (!final_found.valid()) {
+        return std::nullopt;
+    }
+
+    return final_found.padded(1 + (int)server_bounded);
+}
 // ===========================================
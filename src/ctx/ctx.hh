@@ -2,11 +2,23 @@
 
 // ===========================================
 #include <vector>
+#include <span>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <memory_resource>
 #include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+#include <cstring>
 #include <Windows.h>
 #include "../ptr/ptr.hh"
+#include "../pattern/pattern.hh"
+#include "../filter/filter.hh"
+#include "../metrics/metrics.hh"
+#include "../cancel/cancel.hh"
+#include "../io/io.hh"
+#include "../snapshot/snapshot.hh"
 // ===========================================
 
 // ===========================================
@@ -22,12 +34,74 @@ namespace have {
         // DATA
         //
 
-        const char* name = nullptr;
-        uintptr_t start  = 0;
-        uintptr_t size   = 0;
+        const char* name    = nullptr;
+        uintptr_t start     = 0;
+        uintptr_t size      = 0;
+        uintptr_t raw_start = 0;
+        uintptr_t raw_size  = 0;
     };
+
+    struct candidate {
+        //
+        // DATA
+        //
+
+        ptr address       = {};
+        size_t mismatches = 0;
+    };
+
+    struct matches {
+        //
+        // DATA
+        //
+
+        // relative addresses, in order, and where scanning picks up from
+        std::vector<uintptr_t> found = {};
+        uintptr_t resume             = 0;
+        bool done                    = false;
+    };
+
+    // every string of a section, viewed in place, to the relative
+    // addresses it's at, lowest first
+    using string_table = std::unordered_map<std::string_view, std::vector<uint32_t>>;
 }  // namespace have
 
+namespace detail {
+    /**
+     * @brief Lets string keyed containers be looked up by view, without
+     * building a string first
+     * 
+     */
+    struct string_hash {
+        using is_transparent = void;
+
+        inline auto operator()(std::string_view value) const {
+            return std::hash<std::string_view> {}(value);
+        }
+    };
+
+    /**
+     * @brief Image layout per pointer width, PE32 for 32-bit
+     * and PE32+ for 64-bit
+     * 
+     * @tparam W Pointer width
+     */
+    template<typename W>
+    struct image_traits;
+
+    template<>
+    struct image_traits<uint32_t> {
+        using nt_headers            = IMAGE_NT_HEADERS32;
+        constexpr static WORD magic = IMAGE_NT_OPTIONAL_HDR32_MAGIC;
+    };
+
+    template<>
+    struct image_traits<uint64_t> {
+        using nt_headers            = IMAGE_NT_HEADERS64;
+        constexpr static WORD magic = IMAGE_NT_OPTIONAL_HDR64_MAGIC;
+    };
+}  // namespace detail
+
 /**
  * @brief Module context structure
  * 
@@ -48,12 +122,50 @@ struct context {
     [[nodiscard]] context(const HMODULE& module);
 
     /**
-     * @brief Construct a new context object from module handle retrieved
+     * @brief Construct a new context object from a file on disk
      * 
-     * @param path Path to load (!) module from, without TLS callbacks, to local process
+     * Only the headers are read here, address space for the image is reserved and
+     * sections are paged in from the file the first time they are touched. The image
+     * is left unrelocated, so this works with either architecture
+     * 
+     * @param path Path to read module from
      */
     [[nodiscard]] context(const std::string& path);
 
+    /**
+     * @brief Construct a new context object from an image in a process snapshot
+     * 
+     * The image is what the process had in memory, unpacked and relocated to
+     * where it was loaded. Captured in one piece, it's scanned where it lies in
+     * the snapshot's mapping. Otherwise it's copied out, what wasn't captured
+     * being zero filled
+     * 
+     * @param captured Snapshot, has to outlive the context
+     * @param name Image file name, or path ending in one
+     */
+    [[nodiscard]] context(const snapshot::context& captured, std::string_view name);
+
+    context(const context&) = delete;
+    context& operator=(const context&) = delete;
+
+    /**
+     * @brief Destroy the context object
+     * 
+     * Releases the image reservation and file, or the image copy, if owned
+     * 
+     */
+    ~context();
+
+  public:
+    //
+    // ENUMS
+    //
+
+    enum architecture : bool {
+        x86,
+        x64
+    };
+
   private:
     //
     // LOCAL
@@ -63,8 +175,131 @@ struct context {
      * @brief Initialize local data. Exceptions are handled by the user
      * 
      * @param module Module object
+     * @param relocated Whether the loader applied relocations to the image
+     */
+    void initialize(const HMODULE& module, bool relocated = true);
+
+    /**
+     * @brief Release image reservation and file, or image copy, if owned
+     * 
+     */
+    void release();
+
+    /**
+     * @brief Get scan bounds of section, whole image if there's no such section
+     * 
+     * @param section Section name
+     * @return std::pair<uintptr_t, uintptr_t> Start and size
+     */
+    [[nodiscard]] std::pair<uintptr_t, uintptr_t> get_bounds(std::string_view section) const;
+
+    /**
+     * @brief Read section from file a window at a time, the next window
+     * being read while functor works on the current one
+     * 
+     * @tparam F Functor taking the window, how many positions in it belong
+     * to it, its size and its relative address. Returns whether to go on
+     * @param section Section name
+     * @param overlap Bytes each window shares with the next one
+     */
+    template<typename F>
+    void stream(std::string_view section, size_t overlap, F&& functor) const;
+
+    /**
+     * @brief Build string table of a streamed section, a window at a time
+     * 
+     * @param section Section name
+     * @return const string_table& Strings, viewing into their own copies
+     */
+    [[nodiscard]] const string_table& get_streamed_strings(std::string_view section) const;
+
+    /**
+     * @brief Find compiled pattern in a block of bytes
+     * 
+     * @param pattern Compiled pattern
+     * @param first Block
+     * @param starts Positions a match may start at, from first
+     * @param size Block size, matches may run up to its end
+     * @param nth_match Match wanted
+     * @param match Matches found so far, carried across blocks
+     * @param candidates Candidates checked so far
+     * @return const uint8_t* Match, nullptr if it isn't in the block
+     */
+    [[nodiscard]] const uint8_t* scan(const pattern::context& pattern, const uint8_t* first, size_t starts, size_t size, size_t nth_match, size_t& match, size_t& candidates) const;
+
+    /**
+     * @brief Get n-th match of a scan, from the matches found by earlier
+     * calls with the same key, extending them only as far as needed
+     * 
+     * @tparam F Functor taking the relative address to scan from, returning
+     * the next match's, if there's one
+     * @param key Identifies the scan, what's scanned for and where
+     * @param nth_match Match wanted
+     * @param start Relative address a new scan starts at
+     * @param next Functor
+     * @return std::optional<uintptr_t> Relative address of match
+     */
+    template<typename F>
+    [[nodiscard]] std::optional<uintptr_t> find_nth(std::string_view key, size_t nth_match, uintptr_t start, F&& next) const;
+
+    /**
+     * @brief Get matches found so far by the scan key identifies
+     * 
+     * @param key Identifies the scan
+     * @param start Relative address a new scan starts at
+     * @return matches& Matches, stay put as more scans are added
+     */
+    [[nodiscard]] matches& get_matches(std::string_view key, uintptr_t start) const;
+
+    /**
+     * @brief Build key identifying a signature scan, in place
+     * 
+     * @param pattern Compiled pattern
+     * @param section Section scanned
+     * @return const std::string& Key, valid until the next one is built
+     */
+    [[nodiscard]] const std::string& get_signature_key(const pattern::context& pattern, std::string_view section) const;
+
+    /**
+     * @brief Build key identifying a reference scan, in place
+     * 
+     * @tparam W Pointer width
+     * @param rva Relative address referenced
+     * @param section Section scanned
+     * @return const std::string& Key, valid until the next one is built
+     */
+    template<typename W>
+    [[nodiscard]] const std::string& get_reference_key(uint32_t rva, std::string_view section) const;
+
+    /**
+     * @brief Find null terminated string in .rdata
+     * 
+     * @param string The string itself, terminated like find_string's
+     * @param scratch Where temporaries are allocated from
+     * @return std::optional<uintptr_t> Relative address
+     */
+    [[nodiscard]] std::optional<uintptr_t> locate_string(std::string_view string, std::pmr::memory_resource* scratch) const;
+
+    /**
+     * @brief Find every reference to any of targets in one pass
+     * 
+     * @tparam W Pointer width
+     * @param targets Relative addresses referenced
+     * @param section Section scanned
+     */
+    template<typename W>
+    void scan_references(std::span<const uint32_t> targets, std::string_view section) const;
+
+    /**
+     * @brief Charge bytes about to be scanned to the cancellation scope
+     * 
+     * @param bytes Bytes
+     * @return true Scan may go on
+     * @return false Scope is stopped
      */
-    void initialize(const HMODULE& module);
+    [[nodiscard]] inline auto charge(uint64_t bytes) const {
+        return !_cancel || _cancel->charge(bytes);
+    }
 
     //
     // DATA
@@ -74,12 +309,57 @@ struct context {
     bytes _bytes = nullptr;
     size_t _size = 0;
 
-    PIMAGE_DOS_HEADER _dos_header = nullptr;
-    PIMAGE_NT_HEADERS _nt_headers = nullptr;
+    PIMAGE_DOS_HEADER _dos_header   = nullptr;
+    PIMAGE_NT_HEADERS32 _nt_headers = nullptr;
 
-    using sections     = std::unordered_map<std::string, section>;
+    architecture _architecture = architecture::x86;
+
+    // address absolute references inside the image are relative to
+    uint64_t _image_base = 0;
+
+    using sections     = std::unordered_map<std::string, section, detail::string_hash, std::equal_to<>>;
     sections _sections = {};
 
+    // file we page sections in from, none when the image is already resident
+    HANDLE _file = INVALID_HANDLE_VALUE;
+
+    // image copied out of a snapshot it wasn't in one piece in
+    bytes _copy = nullptr;
+
+    using resident                = std::unordered_set<std::string, detail::string_hash, std::equal_to<>>;
+    mutable resident _resident    = {};
+    mutable size_t _resident_size = 0;
+
+    // scans read sections bigger than this through windows this big,
+    // committing only the pages their results land on. 0 pages in. the
+    // image's address space is still reserved whole, results land in it
+    size_t _window                               = 0;
+    mutable std::unordered_set<uintptr_t> _pages = {};
+
+    mutable std::optional<uint64_t> _hash = std::nullopt;
+
+    // scope scans are charged to, none to always run to completion
+    cancel::context* _cancel = nullptr;
+
+    // q-gram filters per section, built or read back on first scan.
+    // written to the cache folder, when there's one
+    using filters                       = std::unordered_map<std::string, filter::context, detail::string_hash, std::equal_to<>>;
+    mutable filters _filters            = {};
+    std::filesystem::path _filter_cache = {};
+
+    // matches of every scan of a section read whole, by what it looked
+    // for and where. the key is built in place, so lookups don't allocate
+    using match_lists                 = std::unordered_map<std::string, matches, detail::string_hash, std::equal_to<>>;
+    mutable match_lists _match_lists  = {};
+    mutable std::string _match_key    = {};
+
+    // string tables per section, built on first lookup. a streamed section's
+    // strings are copied out of its windows, so its table views into these
+    using strings                = std::unordered_map<std::string, string_table, detail::string_hash, std::equal_to<>>;
+    using string_pools           = std::unordered_map<std::string, std::string, detail::string_hash, std::equal_to<>>;
+    mutable strings _strings     = {};
+    mutable string_pools _pooled = {};
+
   public:
     //
     // UTILITY
@@ -105,39 +385,342 @@ struct context {
         return _dos_header;
     }
 
+    /**
+     * @brief Get NT headers as laid out for the image's pointer width
+     * 
+     * @tparam W Pointer width
+     */
+    template<typename W>
     inline auto get_nt_headers() const {
-        return _nt_headers;
+        return (typename detail::image_traits<W>::nt_headers*)_nt_headers;
+    }
+
+    inline auto get_architecture() const {
+        return _architecture;
+    }
+
+    inline auto get_image_base() const {
+        return _image_base;
+    }
+
+    /**
+     * @brief Value which maps an image address back into our mapping
+     * 
+     */
+    inline auto get_rebase() const {
+        return (uintptr_t)_bytes - (uintptr_t)_image_base;
+    }
+
+    /**
+     * @brief Call functor with a value of the image's pointer width type,
+     * so scanners can be instantiated per architecture
+     * 
+     * @param functor Templated functor
+     */
+    template<typename F>
+    inline decltype(auto) visit_width(F&& functor) const {
+        if (_architecture == architecture::x64) {
+            return functor(uint64_t {});
+        }
+
+        return functor(uint32_t {});
     }
 
     [[nodiscard]] inline const auto& get_sections() const {
         return _sections;
     }
 
-    [[nodiscard]] inline const auto& get_section(const std::string& name) const {
-        return _sections.at(name);
+    [[nodiscard]] inline const auto& get_section(std::string_view name) const {
+        // at() has no transparent overload
+        if (auto it = _sections.find(name); it != _sections.end()) {
+            return it->second;
+        }
+
+        throw std::out_of_range("No section named " + std::string {name});
+    }
+
+    inline auto is_resident(std::string_view name) const {
+        return (_file == INVALID_HANDLE_VALUE) || _resident.contains(name);
+    }
+
+    /**
+     * @brief Bytes of section data paged in so far
+     * 
+     */
+    inline auto get_resident_size() const {
+        return _resident_size;
+    }
+
+    /**
+     * @brief Page in section from file, if not already. Unknown
+     * sections page in the whole image, as scans fall back to it
+     * 
+     * @param name Section name
+     */
+    void page_in(std::string_view name) const;
+
+    /**
+     * @brief Commit section's memory, leaving reading it in to the caller.
+     * Unknown sections commit the whole image, as page_in does
+     * 
+     * @param name Section name
+     * @return std::vector<io::extent> Where in the file what's committed is
+     * read from, none if it's resident already. Past them, it's zero filled
+     */
+    [[nodiscard]] std::vector<io::extent> commit(std::string_view name) const;
+
+    /**
+     * @brief Take section committed earlier as paged in, once its
+     * extents are read. Until then, nothing may look at it
+     * 
+     * @param name Section name
+     */
+    void set_resident(std::string_view name) const;
+
+    /**
+     * @brief Page in every section overlapping a range of the image. Of a
+     * streamed section, only the pages overlapping it
+     * 
+     * @param rva Relative address
+     * @param size Range size
+     */
+    void page_in(uintptr_t rva, size_t size) const;
+
+    /**
+     * @brief Give back memory of every paged in section
+     * 
+     */
+    void page_out() const;
+
+    /**
+     * @brief Content hash (XXH64) of the module's file, or of the
+     * image when it's already resident. Computed once, streaming
+     * the file through a small buffer, so nothing gets paged in
+     * 
+     * @return uint64_t Hash
+     */
+    [[nodiscard]] uint64_t get_hash() const;
+
+    /**
+     * @brief Stream sections bigger than window through it when scanning,
+     * rather than paging them in whole. Only works for modules read from file.
+     * This bounds memory committed, not address space reserved
+     * 
+     * @param window Window size in bytes, 0 to page sections in
+     */
+    inline auto set_window(size_t window) {
+        _window = window;
+    }
+
+    inline auto get_window() const {
+        return _window;
+    }
+
+    /**
+     * @brief Whether scans read section through windows rather than paging it in
+     * 
+     * @param section Section name
+     */
+    [[nodiscard]] bool is_streamed(std::string_view section) const;
+
+    /**
+     * @brief Charge scans to scope, they give up with no result once it's
+     * stopped. Checked every chunk of a section, or every window when streamed
+     * 
+     * @param scope Scope, has to outlive the scans. nullptr for none
+     */
+    inline auto set_cancel(cancel::context* scope) {
+        _cancel = scope;
+    }
+
+    inline auto get_cancel() const {
+        return _cancel;
+    }
+
+    /**
+     * @brief Forget every scan's matches, so the next ones scan again
+     * rather than being answered from them. For checking and timing scans
+     * 
+     */
+    inline auto clear_matches() const {
+        _match_lists.clear();
+    }
+
+    /**
+     * @brief Keep q-gram filters in folder across runs, named by content hash
+     * 
+     * @param folder Existing folder
+     */
+    inline auto set_filter_cache(const std::filesystem::path& folder) {
+        _filter_cache = folder;
+    }
+
+    /**
+     * @brief Get q-gram filter of section. Read from the cache if it's
+     * there, else built in one pass over the section and cached
+     * 
+     * @param section Section name, whole image if there's no such section
+     * @return const filter::context& Filter
+     */
+    [[nodiscard]] const filter::context& get_filter(std::string_view section) const;
+
+    /**
+     * @brief Get every NUL terminated, printable string of section, in one
+     * pass. Strings shorter than 4 characters aren't kept. A streamed section
+     * is read a window at a time rather than paged in
+     * 
+     * @param section Section name, whole image if there's no such section
+     * @return const string_table& Strings, to where they are
+     */
+    [[nodiscard]] const string_table& get_strings(std::string_view section) const;
+
+    /**
+     * @brief Whether pointer is inside the image
+     * 
+     * @param pointer Pointer
+     */
+    inline auto contains(const ptr& pointer) const {
+        return (pointer.get() >= (uintptr_t)_bytes) && (pointer.get() < ((uintptr_t)_bytes + _size));
+    }
+
+    /**
+     * @brief Dereference pointer inside the image with respect to its pointer width
+     * 
+     * @param pointer Pointer inside the image
+     * @param n Times to dereference
+     * @return ptr Copy of pointer
+     */
+    [[nodiscard]] inline ptr dereferenced(const ptr& pointer, size_t n) const {
+        return visit_width([&]<typename W>(W) {
+            // one step at a time, every pointer read has to be paged in first
+            auto out = pointer;
+            for (auto i = 0; i < n; ++i) {
+                if (!contains(out)) {
+                    throw std::runtime_error("Failed dereferencing.");
+                }
+
+                page_in(out.get() - (uintptr_t)_bytes, sizeof(W));
+                out.template dereference<W>(1);
+            }
+
+            return out;
+        });
+    }
+
+    /**
+     * @brief Read value at image address, as the image's own pointers hold them
+     * 
+     * @tparam T Value type
+     * @param address Image address
+     * @return std::optional<T> Value, if it's inside the image
+     */
+    template<typename T>
+    [[nodiscard]] inline std::optional<T> read(uint64_t address) const {
+        if ((address < _image_base) || ((address + sizeof(T)) > (_image_base + _size))) {
+            return std::nullopt;
+        }
+
+        const auto rva = (uintptr_t)(address - _image_base);
+        page_in(rva, sizeof(T));
+
+        T out;
+        std::memcpy(&out, (const void*)get_at(rva), sizeof(T));
+        return out;
     }
 
     /**
-     * @brief Find byte array pattern in bytes
+     * @brief Read name at image address
      * 
-     * @param bytes Dynamic address to said bytes
-     * @param size Size of byte array pointed to
+     * @param address Image address
+     * @return std::string_view Name, empty if it isn't a printable, terminated one
+     */
+    [[nodiscard]] std::string_view read_name(uint64_t address) const;
+
+    /**
+     * @brief Find compiled pattern in bytes. Patterns the section's q-gram
+     * filter rejects aren't scanned for, the rest get candidates from the
+     * engine the pattern picked for its shape
+     * 
+     * @param pattern Compiled pattern
      * @param section Module section to scan through
      * @param nth_match N-th selection of a repeating pattern
      * @return std::optional<ptr> Contained pointer
      */
-    [[nodiscard]] std::optional<ptr> find_signature(const int* bytes, size_t size, const std::string& section, size_t nth_match) const;
+    [[nodiscard]] std::optional<ptr> find_signature(const pattern::context& pattern, std::string_view section, size_t nth_match) const;
+
+    /**
+     * @brief Scan with every engine pattern supports, matches cleared before
+     * each, so no engine is answered from another's matches
+     * 
+     * @param pattern Compiled pattern
+     * @param section Module section to scan through
+     * @param nth_match N-th selection of a repeating pattern
+     * @return std::vector<std::pair<pattern::context::engine, std::optional<ptr>>> What each engine found
+     */
+    [[nodiscard]] std::vector<std::pair<pattern::context::engine, std::optional<ptr>>> find_signature_each(const pattern::context& pattern, std::string_view section, size_t nth_match) const;
+
+    /**
+     * @brief Scan section once for several patterns, a chunk at a time, each
+     * chunk being scanned for every pattern still short of the match wanted
+     * of it while it's cached. Matches go to the match lists, find_signature
+     * then looks them up. Streamed sections are left to find_signature
+     * 
+     * @param wanted Compiled patterns, and the match wanted of each
+     * @param section Module section to scan through
+     */
+    void scan_signatures(std::span<const std::pair<const pattern::context*, size_t>> wanted, std::string_view section) const;
+
+    /**
+     * @brief Find every reference to any of strings in one pass, rather than
+     * a scan per string. Every reference goes to the match lists, which
+     * find_string then looks them up in. Streamed sections are left to find_string
+     * 
+     * @param strings Strings, terminated like find_string's
+     * @param section Section to scan for references
+     * @param scratch Where temporaries are allocated from
+     */
+    void scan_references(std::span<const std::string_view> strings, std::string_view section, std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) const;
+
+    /**
+     * @brief Find where compiled pattern comes closest to matching, allowing
+     * up to a number of its bytes to differ. Shift-Or, one state per
+     * mismatch count, as many words as the pattern needs
+     * 
+     * @param pattern Compiled pattern
+     * @param section Module section to scan through
+     * @param mismatches Most bytes a candidate may get wrong
+     * @param limit Most candidates returned
+     * @param scratch Where temporaries and the result are allocated from
+     * @return std::pmr::vector<candidate> Fewest mismatches first, then by address
+     */
+    [[nodiscard]] std::pmr::vector<candidate> find_nearest(const pattern::context& pattern, std::string_view section, size_t mismatches, size_t limit, std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) const;
+
+    /**
+     * @brief Find references to an address inside the image. Absolute
+     * for x86, RIP-relative disp32 for x64
+     * 
+     * @tparam W Pointer width
+     * @param target Pointer inside the image to find references of
+     * @param section Module section to scan through
+     * @param nth_match N-th reference
+     * @return std::optional<ptr> Contained pointer, at the reference itself
+     */
+    template<typename W>
+    [[nodiscard]] std::optional<ptr> find_reference(const ptr& target, std::string_view section, size_t nth_match) const;
 
     /**
-     * @brief Find null terminated string in .rdata then scan for address in .text
+     * @brief Find null terminated string in .rdata then scan for references in section.
+     * The string is looked up in .rdata's string table, and only scanned for
+     * when it isn't in there whole
      * 
-     * @param bytes The string itself
-     * @param size String size
+     * @param string The string itself, its terminator has to follow it in
+     * memory, as std::string's and parsed JSON strings' do
      * @param section Section to scan for references
      * @param reference_instance N-th reference
+     * @param scratch Where temporaries are allocated from
      * @return std::optional<ptr> Contained pointer
      */
-    [[nodiscard]] std::optional<ptr> find_string(const char* bytes, size_t size, const std::string& section, size_t reference_instance) const;
+    [[nodiscard]] std::optional<ptr> find_string(std::string_view string, std::string_view section, size_t reference_instance, std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) const;
 
     /**
      * @brief Find exported procedure address in DLL
@@ -145,18 +728,18 @@ struct context {
      * @param name Procedure name
      * @return std::optional<ptr> Contained pointer
      */
-    [[nodiscard]] std::optional<ptr> find_procedure(const std::string& name) const;
+    [[nodiscard]] std::optional<ptr> find_procedure(std::string_view name) const;
 
     /**
      * @brief CS:GO/Source-Engine specific - Find ConVar with string by constructor, return pointer
      * 
-     * @param bytes The string/convar name itself
-     * @param size String size
+     * @param name The convar name itself, terminated like find_string's
      * @param server_bounded Constructor type, non-server-bounded example (CS:GO):
      * r_aspectratio, server-bounded example: cl_cmdrate
+     * @param scratch Where temporaries are allocated from
      * @return std::optional<ptr> Contained pointer
      */
-    [[nodiscard]] std::optional<ptr> find_convar(const char* bytes, size_t size, bool server_bounded) const;
+    [[nodiscard]] std::optional<ptr> find_convar(std::string_view name, bool server_bounded, std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) const;
 };
 }  // namespace modules
 // ===========================================
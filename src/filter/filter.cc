@@ -0,0 +1,157 @@
+/**
+ * @file filter.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Section q-gram prefilter
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "filter.hh"
+#include <Windows.h>
+#include <algorithm>
+#include <fstream>
+#include <bit>
+// ===========================================
+
+// ===========================================
+namespace filter {
+namespace detail {
+// stored ahead of the bitmap on disk
+struct header {
+    char magic[4]    = {'A', 'Q', 'G', 'F'};
+    uint32_t version = 1;
+    uint64_t size    = 0;
+    uint32_t bits    = 0;
+    uint32_t padding = 0;
+};
+
+// one bit per q-gram is 2 MiB, a bitmap of 8 bits per byte keeps
+// hashed ones sparse enough for a clear bit to be worth something
+constexpr uint32_t min_bits = 12;
+constexpr uint32_t max_bits = 24;
+}  // namespace detail
+}  // namespace filter
+
+using namespace filter;
+context::context(const uint8_t* bytes, size_t size)
+    : context(size) {
+    add(bytes, size);
+}
+
+context::context(size_t size)
+    : _size(size) {
+    _bits = std::clamp<uint32_t>((uint32_t)std::bit_width(std::max<uint64_t>(size, 1) * 8 - 1), detail::min_bits, detail::max_bits);
+    _words.assign(((size_t)1 << _bits) / 64, 0);
+}
+
+void context::add(const uint8_t* bytes, size_t size) {
+    if (size < 3) {
+        return;
+    }
+
+    // bound by misses on the bitmap, not by reading bytes. the
+    // loop is split so the exact one has nothing else in it
+    const auto words = _words.data();
+
+    uint32_t gram = (bytes[0] << 8) | (bytes[1] << 16);
+    if (_bits == detail::max_bits) {
+        for (size_t i = 2; i < size; ++i) {
+            gram = ((gram >> 8) | ((uint32_t)bytes[i] << 16));
+            words[gram / 64] |= (1ull << (gram % 64));
+        }
+    } else {
+        for (size_t i = 2; i < size; ++i) {
+            gram           = ((gram >> 8) | ((uint32_t)bytes[i] << 16));
+            const auto bit = index(gram);
+            words[bit / 64] |= (1ull << (bit % 64));
+        }
+    }
+}
+
+bool context::admits(const pattern::context& pattern) const {
+    const auto& value = pattern.get_value();
+    const auto& mask  = pattern.get_mask();
+
+    for (size_t i = 0; (i + 3) <= pattern.get_size(); ++i) {
+        if ((mask[i] != 0xFF) || (mask[i + 1] != 0xFF) || (mask[i + 2] != 0xFF)) {
+            continue;
+        }
+
+        const auto bit = index(value[i] | (value[i + 1] << 8) | (value[i + 2] << 16));
+        if (!(_words[bit / 64] & (1ull << (bit % 64)))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::optional<context> context::load(const std::filesystem::path& path, size_t size) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    detail::header header = {}, expected = {};
+    file.read((char*)&header, sizeof(header));
+
+    if (!file || !std::ranges::equal(header.magic, expected.magic) || (header.version != expected.version) || (header.size != size)) {
+        return std::nullopt;
+    }
+
+    if ((header.bits < detail::min_bits) || (header.bits > detail::max_bits)) {
+        return std::nullopt;
+    }
+
+    context out = {};
+    out._size   = header.size;
+    out._bits   = header.bits;
+    out._words.resize(((size_t)1 << header.bits) / 64);
+
+    file.read((char*)out._words.data(), out._words.size() * sizeof(uint64_t));
+    if (!file) {
+        return std::nullopt;
+    }
+
+    return out;
+}
+
+bool context::save(const std::filesystem::path& path) const {
+    // worker processes share the cache, and may well index the same module at
+    // once. each writes its own file and renames it over, so a reader only
+    // ever sees one of them whole
+    auto temporary = path;
+    temporary += '.' + std::to_string(GetCurrentProcessId()) + ".tmp";
+
+    auto written = false;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (file) {
+            detail::header header = {};
+            header.size           = _size;
+            header.bits           = _bits;
+
+            file.write((const char*)&header, sizeof(header));
+            file.write((const char*)_words.data(), _words.size() * sizeof(uint64_t));
+        }
+
+        written = file.good();
+    }
+
+    std::error_code error = {};
+    if (written) {
+        std::filesystem::rename(temporary, path, error);
+    }
+
+    if (!written || error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+
+    return true;
+}
+// ===========================================
@@ -0,0 +1,121 @@
+#pragma once
+
+// ===========================================
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <filesystem>
+#include "../pattern/pattern.hh"
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains section prefilter structs
+ * restrained to context
+ * 
+ */
+namespace filter {
+/**
+ * @brief Which 3 byte sequences (q-grams) occur in a block of bytes, one
+ * bit each. Exact for big blocks, hashed into a smaller bitmap for small
+ * ones, so a clear bit always means the q-gram is absent. A pattern
+ * whose exact q-grams aren't all present can't match anywhere
+ * 
+ */
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object, in one pass over bytes
+     * 
+     * @param bytes Bytes to index
+     * @param size Byte count
+     */
+    [[nodiscard]] context(const uint8_t* bytes, size_t size);
+
+    /**
+     * @brief Construct a new, empty, context object, for bytes given to add()
+     * 
+     * @param size Byte count it will have indexed
+     */
+    [[nodiscard]] explicit context(size_t size);
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Bit of q-gram
+     * 
+     * @param gram Three bytes, first one lowest
+     */
+    inline auto index(uint32_t gram) const {
+        // every q-gram gets its own bit once the bitmap is that big
+        return (_bits == 24) ? gram : ((gram * 0x9E3779B1u) >> (32 - _bits));
+    }
+
+    //
+    // DATA
+    //
+
+    // bytes indexed, and log2 of the bitmap's size in bits
+    uint64_t _size = 0;
+    uint32_t _bits = 0;
+
+    std::vector<uint64_t> _words = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    /**
+     * @brief Index block of the bytes, q-grams of blocks that follow each
+     * other are only all indexed when each block starts with the previous
+     * one's last two bytes
+     * 
+     * @param bytes Block
+     * @param size Block size
+     */
+    void add(const uint8_t* bytes, size_t size);
+
+    inline auto get_size() const {
+        return _size;
+    }
+
+    /**
+     * @brief Whether pattern could match in the indexed bytes. Only runs
+     * of exact bytes are looked up, so this never rejects a match
+     * 
+     * @param pattern Compiled pattern
+     */
+    [[nodiscard]] bool admits(const pattern::context& pattern) const;
+
+    //
+    // EXPORT
+    //
+
+    /**
+     * @brief Read filter back from disk
+     * 
+     * @param path File written by save()
+     * @param size Byte count the filter has to have indexed
+     * @return std::optional<context> Filter, if the file is one, and of size
+     */
+    [[nodiscard]] static std::optional<context> load(const std::filesystem::path& path, size_t size);
+
+    /**
+     * @brief Write filter to disk, through a temporary file renamed in place
+     * 
+     * @param path Destination
+     * @return bool Whether it was written
+     */
+    bool save(const std::filesystem::path& path) const;
+};
+}  // namespace filter
+// ===========================================
@@ -0,0 +1,197 @@
+/**
+ * @file fleet.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Worker processes, and messages to and from them
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "fleet.hh"
+#include <mutex>
+#include <thread>
+#include <algorithm>
+// ===========================================
+
+// ===========================================
+namespace fleet {
+namespace detail {
+// a length past this isn't one a worker wrote, the pipe's out of step
+constexpr uint32_t max_message = 1 << 30;
+
+// a worker whose pipes are closed is given this long to exit on its own
+constexpr DWORD grace = 1000;
+
+// inheritable handles go to whichever process is started next, so making
+// a worker's pipes and starting it with them is done one worker at a time
+inline std::mutex spawning = {};
+
+/**
+ * Write all of size bytes, false once the reading end is gone
+ */
+inline bool write(HANDLE pipe, const void* in, size_t size) {
+    const auto* bytes = (const uint8_t*)in;
+    while (size) {
+        DWORD written = 0;
+        if (!WriteFile(pipe, bytes, (DWORD)std::min<size_t>(size, MAXDWORD), &written, nullptr) || !written) {
+            return false;
+        }
+
+        bytes += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+/**
+ * Read all of size bytes, false once the writing end is gone
+ */
+inline bool read(HANDLE pipe, void* out, size_t size) {
+    auto* bytes = (uint8_t*)out;
+    while (size) {
+        DWORD read = 0;
+        if (!ReadFile(pipe, bytes, (DWORD)std::min<size_t>(size, MAXDWORD), &read, nullptr) || !read) {
+            return false;
+        }
+
+        bytes += read;
+        size -= read;
+    }
+
+    return true;
+}
+
+inline void close(HANDLE& handle) {
+    if (handle) {
+        CloseHandle(handle);
+        handle = nullptr;
+    }
+}
+}  // namespace detail
+}  // namespace fleet
+
+using namespace fleet;
+bool fleet::send(HANDLE pipe, std::string_view message) {
+    const auto size = (uint32_t)message.size();
+    return detail::write(pipe, &size, sizeof(size)) && detail::write(pipe, message.data(), message.size());
+}
+
+std::optional<std::string> fleet::receive(HANDLE pipe) {
+    uint32_t size = 0;
+    if (!detail::read(pipe, &size, sizeof(size)) || (size > detail::max_message)) {
+        return std::nullopt;
+    }
+
+    std::string out(size, '\0');
+    if (!detail::read(pipe, out.data(), size)) {
+        return std::nullopt;
+    }
+
+    return out;
+}
+
+context::context(const std::string& command) {
+    std::scoped_lock lock(detail::spawning);
+
+    SECURITY_ATTRIBUTES inherited = {};
+    inherited.nLength             = sizeof(inherited);
+    inherited.bInheritHandle      = TRUE;
+
+    // the worker's ends, closed here once it has its own
+    HANDLE in  = nullptr;
+    HANDLE out = nullptr;
+
+    auto started = CreatePipe(&in, &_to, &inherited, 0) && CreatePipe(&_from, &out, &inherited, 0);
+    if (started) {
+        // ours stay here, or the worker would hold its own pipes open
+        SetHandleInformation(_to, HANDLE_FLAG_INHERIT, 0);
+        SetHandleInformation(_from, HANDLE_FLAG_INHERIT, 0);
+
+        auto line = command + ' ' + std::to_string((uintptr_t)in) + ' ' + std::to_string((uintptr_t)out);
+
+        STARTUPINFOA startup     = {};
+        startup.cb               = sizeof(startup);
+        PROCESS_INFORMATION info = {};
+
+        started = CreateProcessA(nullptr, line.data(), nullptr, nullptr, TRUE, 0, nullptr, nullptr, &startup, &info);
+        if (started) {
+            CloseHandle(info.hThread);
+            _process = info.hProcess;
+        }
+    }
+
+    detail::close(in);
+    detail::close(out);
+
+    if (!started) {
+        release();
+        throw std::runtime_error("Failed starting worker.");
+    }
+}
+
+context::~context() {
+    release();
+}
+
+void context::release() {
+    detail::close(_to);
+    detail::close(_from);
+
+    if (_process) {
+        if (WaitForSingleObject(_process, detail::grace) != WAIT_OBJECT_0) {
+            TerminateProcess(_process, EXIT_FAILURE);
+        }
+
+        detail::close(_process);
+    }
+}
+
+std::optional<std::string> context::receive(DWORD timeout) {
+    if (timeout == INFINITE) {
+        return fleet::receive(_from);
+    }
+
+    // the read can't be given a deadline on an anonymous pipe, so the worker
+    // is watched instead. terminating it breaks the pipe, ending the read
+    auto replied = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!replied) {
+        return fleet::receive(_from);
+    }
+
+    std::thread watchdog([&]() {
+        const HANDLE handles[] = {replied, _process};
+        if (WaitForMultipleObjects(2, handles, FALSE, timeout) == WAIT_TIMEOUT) {
+            _timed_out = true;
+            TerminateProcess(_process, EXIT_FAILURE);
+        }
+    });
+
+    auto out = fleet::receive(_from);
+
+    SetEvent(replied);
+    watchdog.join();
+    CloseHandle(replied);
+
+    // a reply that made it just as it was terminated is still dropped, the
+    // worker's gone either way
+    if (_timed_out) {
+        return std::nullopt;
+    }
+
+    return out;
+}
+
+std::optional<DWORD> context::get_exit_code() const {
+    // a worker that closed its pipes may not be all the way out yet
+    DWORD code = STILL_ACTIVE;
+    if (!_process || (WaitForSingleObject(_process, detail::grace) != WAIT_OBJECT_0) || !GetExitCodeProcess(_process, &code)) {
+        return std::nullopt;
+    }
+
+    return code;
+}
+// ===========================================
@@ -0,0 +1,208 @@
+#pragma once
+
+// ===========================================
+#include <Windows.h>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains worker process structs
+ * restrained to context
+ * 
+ */
+namespace fleet {
+namespace have {
+    /**
+     * @brief Builds a message. Numbers go in as their bytes, little
+     * endian as both ends are, strings as a 32-bit length then theirs
+     * 
+     */
+    struct writer {
+        //
+        // DATA
+        //
+
+        std::string bytes = {};
+
+        //
+        // UTILITY
+        //
+
+        template<typename T>
+        requires std::is_arithmetic_v<T>
+        inline auto& put(T value) {
+            bytes.append((const char*)&value, sizeof(T));
+            return *this;
+        }
+
+        inline auto& put(std::string_view value) {
+            put((uint32_t)value.size());
+            bytes.append(value);
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Takes a message apart, in the order it was built
+     * 
+     */
+    struct reader {
+        //
+        // DATA
+        //
+
+        std::string_view bytes = {};
+        size_t at              = 0;
+
+        //
+        // UTILITY
+        //
+
+        /**
+         * @brief Take number
+         * 
+         * @tparam T Number type it was put as
+         * @return T Number
+         */
+        template<typename T>
+        requires std::is_arithmetic_v<T>
+        [[nodiscard]] inline T take() {
+            T out = {};
+            std::memcpy(&out, take_bytes(sizeof(T)), sizeof(T));
+            return out;
+        }
+
+        [[nodiscard]] inline std::string take_string() {
+            const auto size = take<uint32_t>();
+            return std::string {take_bytes(size), size};
+        }
+
+        [[nodiscard]] inline const char* take_bytes(size_t size) {
+            if (size > (bytes.size() - at)) {
+                throw std::runtime_error("Message is truncated.");
+            }
+
+            const auto* out = bytes.data() + at;
+            at += size;
+            return out;
+        }
+    };
+}  // namespace have
+
+using namespace have;
+
+/**
+ * @brief Write message to pipe, framed by its 32-bit length
+ * 
+ * @param pipe Pipe
+ * @param message Message
+ * @return true Written whole
+ * @return false The other end is gone
+ */
+bool send(HANDLE pipe, std::string_view message);
+
+/**
+ * @brief Read message off pipe, blocking until there's a whole one
+ * 
+ * @param pipe Pipe
+ * @return std::optional<std::string> Message, none once the other end is gone
+ */
+[[nodiscard]] std::optional<std::string> receive(HANDLE pipe);
+
+/**
+ * @brief A worker process, talked to through a pipe each way. Its ends of
+ * them are passed to it on its command line, as "<read> <write>" handle
+ * values after what it's started with
+ * 
+ * One that crashes, or exits, closes its ends, so sending or receiving
+ * fails rather than blocking. Workers are only ever handed the pipes
+ * they were made with, so no other process holds them open. One that
+ * hangs is terminated once a reply is past its deadline, which ends
+ * up the same
+ * 
+ */
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    /**
+     * @brief Construct a new context object, starting the worker
+     * 
+     * @param command Command line, its pipes' handles are appended to it
+     */
+    [[nodiscard]] context(const std::string& command);
+
+    context(const context&) = delete;
+    context& operator=(const context&) = delete;
+
+    /**
+     * @brief Destroy the context object
+     * 
+     * Closes its pipes, which a worker takes as being done with, and
+     * waits on it exiting for a bit before terminating it
+     * 
+     */
+    ~context();
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Close pipes and process
+     * 
+     */
+    void release();
+
+    //
+    // DATA
+    //
+
+    HANDLE _process = nullptr;
+
+    // our ends
+    HANDLE _to   = nullptr;
+    HANDLE _from = nullptr;
+
+    // terminated for not replying in time
+    bool _timed_out = false;
+
+  public:
+    //
+    // UTILITY
+    //
+
+    [[nodiscard]] inline bool send(std::string_view message) const {
+        return fleet::send(_to, message);
+    }
+
+    /**
+     * @brief Read reply, terminating the worker if it isn't whole by timeout
+     * 
+     * @param timeout Milliseconds, or INFINITE
+     * @return std::optional<std::string> Reply, none once the worker is gone
+     */
+    [[nodiscard]] std::optional<std::string> receive(DWORD timeout = INFINITE);
+
+    [[nodiscard]] inline bool has_timed_out() const {
+        return _timed_out;
+    }
+
+    /**
+     * @brief Get how the worker exited, giving one that's on its way out a bit
+     * 
+     * @return std::optional<DWORD> Exit code, none if it's still running
+     */
+    [[nodiscard]] std::optional<DWORD> get_exit_code() const;
+};
+}  // namespace fleet
+// ===========================================
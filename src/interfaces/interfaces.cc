@@ -0,0 +1,257 @@
+/**
+ * @file interfaces.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Source engine interface registry
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "interfaces.hh"
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+// ===========================================
+
+// ===========================================
+namespace interfaces {
+namespace detail {
+// bytes of CreateInterface, and of whatever it jumps to, looked through
+constexpr uint32_t code_window = 0x40;
+constexpr size_t max_jumps     = 2;
+
+// a registry is a few hundred nodes at most, anything longer loops
+constexpr size_t max_nodes = 0x1000;
+}  // namespace detail
+}  // namespace interfaces
+
+using namespace interfaces;
+context::context(const modules::context& module)
+    : _module(&module) {
+    module.visit_width([&]<typename W>(W) {
+        build<W>();
+    });
+}
+
+template<typename W>
+std::optional<uint32_t> context::find_head() const {
+    const auto& module = *_module;
+    constexpr auto x64 = std::is_same_v<W, uint64_t>;
+
+    const auto procedure = module.find_procedure("CreateInterface");
+    if (!procedure.has_value() || !module.get_sections().contains(".data")) {
+        return std::nullopt;
+    }
+
+    // the head has to be a global, everything else the code loads isn't it
+    const auto& data     = module.get_section(".data");
+    const auto is_global = [&](int64_t rva) {
+        return (rva >= (int64_t)data.start) && ((rva + sizeof(W)) <= (data.start + data.size));
+    };
+
+    auto at = (uint32_t)(procedure.value().get() - (uintptr_t)module.get_bytes());
+    for (size_t jumps = 0; jumps <= detail::max_jumps; ++jumps) {
+        // the longest load looked for is 7 bytes
+        if ((at + detail::code_window + 8) > module.get_size()) {
+            return std::nullopt;
+        }
+
+        module.page_in(at, detail::code_window + 8);
+
+        std::optional<uint32_t> jump = std::nullopt;
+        for (uint32_t i = at; i < (at + detail::code_window); ++i) {
+            const auto byte = module.get_byte(i);
+
+            // mov reg, [disp32], absolute on x86 and rip-relative behind a
+            // REX.W on x64. and mov eax, [moffs32] on x86
+            if (!x64 && byte == 0x8B && (module.get_byte(i + 1) & 0xC7) == 0x05) {
+                const auto rva = (int64_t)module.read<uint32_t>(module.get_image_base() + i + 2).value_or(0) - (int64_t)module.get_image_base();
+                if (is_global(rva)) {
+                    return (uint32_t)rva;
+                }
+            } else if (!x64 && byte == 0xA1) {
+                const auto rva = (int64_t)module.read<uint32_t>(module.get_image_base() + i + 1).value_or(0) - (int64_t)module.get_image_base();
+                if (is_global(rva)) {
+                    return (uint32_t)rva;
+                }
+            } else if (x64 && (byte & 0xF8) == 0x48 && module.get_byte(i + 1) == 0x8B && (module.get_byte(i + 2) & 0xC7) == 0x05) {
+                const auto rva = (int64_t)(i + 7) + module.read<int32_t>(module.get_image_base() + i + 3).value_or(0);
+                if (is_global(rva)) {
+                    return (uint32_t)rva;
+                }
+            } else if (byte == 0xE9 && !jump.has_value()) {
+                // the export is usually a thunk into CreateInterfaceInternal
+                jump = (uint32_t)((int64_t)(i + 5) + module.read<int32_t>(module.get_image_base() + i + 1).value_or(0));
+            }
+        }
+
+        if (!jump.has_value()) {
+            return std::nullopt;
+        }
+
+        at = jump.value();
+    }
+
+    return std::nullopt;
+}
+
+template<typename W>
+std::vector<uint32_t> context::find_relocated(std::string_view section) const {
+    const auto& module = *_module;
+    constexpr auto x64 = std::is_same_v<W, uint64_t>;
+
+    const auto& directory = module.get_nt_headers<W>()->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_BASERELOC];
+    if (!directory.VirtualAddress || ((directory.VirtualAddress + (uint64_t)directory.Size) > module.get_size())) {
+        return {};
+    }
+
+    module.page_in(directory.VirtualAddress, directory.Size);
+
+    const auto& value = module.get_section(section);
+
+    // blocks of 16-bit entries, a type in the top 4 bits and
+    // an offset into the block's page in the rest
+    std::vector<uint32_t> out = {};
+    for (uint32_t at = 0; (at + sizeof(IMAGE_BASE_RELOCATION)) <= directory.Size;) {
+        const auto block = (const IMAGE_BASE_RELOCATION*)module.get_at(directory.VirtualAddress + at);
+        if ((block->SizeOfBlock < sizeof(IMAGE_BASE_RELOCATION)) || (block->SizeOfBlock > (directory.Size - at))) {
+            break;
+        }
+
+        const auto entries = (const WORD*)(block + 1);
+        const auto count   = (block->SizeOfBlock - sizeof(IMAGE_BASE_RELOCATION)) / sizeof(WORD);
+        for (size_t i = 0; i < count; ++i) {
+            const auto type = entries[i] >> 12;
+            const auto rva  = block->VirtualAddress + (entries[i] & 0xFFF);
+            if ((type != (x64 ? IMAGE_REL_BASED_DIR64 : IMAGE_REL_BASED_HIGHLOW)) || (rva < value.start) || ((rva + sizeof(W)) > (value.start + value.size))) {
+                continue;
+            }
+
+            out.push_back(rva);
+        }
+
+        at += block->SizeOfBlock;
+    }
+
+    std::ranges::sort(out);
+    return out;
+}
+
+template<typename W>
+std::optional<W> context::add(uint64_t node, bool versioned) {
+    const auto& module = *_module;
+
+    const auto factory = module.read<W>(node);
+    const auto name    = module.read_name(module.read<W>(node + sizeof(W)).value_or(0));
+    const auto next    = module.read<W>(node + (2 * sizeof(W)));
+    if (!factory.has_value() || !next.has_value() || name.empty()) {
+        return std::nullopt;
+    }
+
+    const auto base = module.get_image_base();
+    if (factory.value() < base || factory.value() >= (base + module.get_size())) {
+        return std::nullopt;
+    }
+
+    if (versioned && (!std::isdigit((unsigned char)name.back()) || name.find(' ') != std::string_view::npos)) {
+        return std::nullopt;
+    }
+
+    registration out = {(uint32_t)(factory.value() - base), 0};
+
+    // return &s_Instance compiles to mov eax, imm32; ret on x86,
+    // and lea rax, [rip + disp32]; ret on x64
+    if constexpr (std::is_same_v<W, uint64_t>) {
+        const auto code = module.read<uint64_t>(factory.value());
+        if (code.has_value() && (code.value() & 0xFFFFFF) == 0x058D48 && ((code.value() >> 56) & 0xFF) == 0xC3) {
+            out.instance = (uint32_t)((int64_t)out.factory + 7 + (int32_t)(code.value() >> 24));
+        }
+    } else {
+        const auto code   = module.read<uint8_t>(factory.value());
+        const auto target = module.read<uint32_t>(factory.value() + 1);
+        const auto ret    = module.read<uint8_t>(factory.value() + 5);
+        if (code == 0xB8 && ret == 0xC3 && target.value() >= base && target.value() < (base + module.get_size())) {
+            out.instance = (uint32_t)(target.value() - base);
+        }
+    }
+
+    _interfaces.emplace(name, out);
+    return next;
+}
+
+template<typename W>
+void context::build() {
+    const auto& module = *_module;
+
+    const auto head = find_head<W>();
+    if (head.has_value()) {
+        std::unordered_set<uint64_t> visited = {};
+
+        auto node = module.read<W>(module.get_image_base() + head.value()).value_or(0);
+        while (node && visited.size() < detail::max_nodes && visited.insert(node).second) {
+            node = add<W>(node, false).value_or(0);
+        }
+
+        if (!_interfaces.empty()) {
+            return;
+        }
+    }
+
+    if (!module.get_sections().contains(".data")) {
+        return;
+    }
+
+    // nothing linked on disk, statically initialized nodes are still there.
+    // their factory and name are pointers the loader fixes up, so where
+    // there are relocations only two relocated slots in a row are looked at
+    const auto relocated = find_relocated<W>(".data");
+    if (!relocated.empty()) {
+        for (size_t i = 1; i < relocated.size(); ++i) {
+            if (relocated[i] == (relocated[i - 1] + sizeof(W))) {
+                add<W>(module.get_image_base() + relocated[i - 1], true);
+            }
+        }
+
+        return;
+    }
+
+    // without them, every slot is
+    module.page_in(".data");
+
+    const auto& data = module.get_section(".data");
+    for (auto i = data.start; (i + (3 * sizeof(W))) <= (data.start + data.size); i += sizeof(W)) {
+        add<W>(module.get_image_base() + i, true);
+    }
+}
+
+const registration* context::find_interface(std::string_view name) const {
+    if (auto found = _interfaces.find(name); found != _interfaces.end()) {
+        return &found->second;
+    }
+
+    // versions get bumped by updates, a bare name picks whichever is there
+    const registration* out = nullptr;
+    for (const auto& [version, value] : _interfaces) {
+        if (version.size() <= name.size() || !version.starts_with(name)) {
+            continue;
+        }
+
+        if (!std::all_of(version.begin() + name.size(), version.end(), [](char c) {
+                return std::isdigit((unsigned char)c);
+            })) {
+            continue;
+        }
+
+        if (out) {
+            return nullptr;
+        }
+
+        out = &value;
+    }
+
+    return out;
+}
+// ===========================================
@@ -0,0 +1,131 @@
+#pragma once
+
+// ===========================================
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../ctx/ctx.hh"
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains Source engine interface registry structs
+ * restrained to context
+ * 
+ */
+namespace interfaces {
+namespace have {
+    struct registration {
+        //
+        // DATA
+        //
+
+        // relative addresses
+        uint32_t factory = 0;
+
+        // 0 when the factory doesn't plainly return a global's address
+        uint32_t instance = 0;
+    };
+}  // namespace have
+
+/**
+ * @brief Every InterfaceReg a module registers, by version string. The
+ * list head is taken from the first load in CreateInterface's code (jumps
+ * to CreateInterfaceInternal followed) and the nodes are walked once:
+ * { create function, name, next }
+ * 
+ * On disk, the head and nodes are only there if they were statically
+ * initialized. When the head is empty, nodes are picked out of .data by
+ * that same shape, with version names ending in digits
+ * 
+ */
+using namespace have;
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object, walking module's registry
+     * 
+     * @param module Module, has to outlive the walk, names point into it
+     */
+    [[nodiscard]] context(const modules::context& module);
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Walk image laid out for pointer width
+     * 
+     * @tparam W Pointer width
+     */
+    template<typename W>
+    void build();
+
+    /**
+     * @brief Find where CreateInterface loads the list head from
+     * 
+     * @tparam W Pointer width
+     * @return std::optional<uint32_t> Relative address of s_pInterfaceRegs
+     */
+    template<typename W>
+    [[nodiscard]] std::optional<uint32_t> find_head() const;
+
+    /**
+     * @brief Find every slot of section the loader fixes a pointer up in,
+     * from the base relocations
+     * 
+     * @tparam W Pointer width
+     * @param section Section name
+     * @return std::vector<uint32_t> Relative addresses, in order. Empty if
+     * there are no relocations
+     */
+    template<typename W>
+    [[nodiscard]] std::vector<uint32_t> find_relocated(std::string_view section) const;
+
+    /**
+     * @brief Index node, if it's shaped like one
+     * 
+     * @tparam W Pointer width
+     * @param node Image address of InterfaceReg
+     * @param versioned Only take names ending in a digit
+     * @return std::optional<W> Image address of next node, if node was indexed
+     */
+    template<typename W>
+    std::optional<W> add(uint64_t node, bool versioned);
+
+    //
+    // DATA
+    //
+
+    const modules::context* _module = nullptr;
+
+    std::unordered_map<std::string_view, registration> _interfaces = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    [[nodiscard]] inline const auto& get_interfaces() const {
+        return _interfaces;
+    }
+
+    /**
+     * @brief Find interface
+     * 
+     * @param name Version string, like VEngineClient014. Without the
+     * version digits, it has to be the only one registered under that name
+     * @return const registration* Registration, nullptr if there's no such one
+     */
+    [[nodiscard]] const registration* find_interface(std::string_view name) const;
+};
+}  // namespace interfaces
+// ===========================================
@@ -0,0 +1,160 @@
+/**
+ * @file io.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Pooled, read ahead file reading
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "io.hh"
+#include <algorithm>
+// ===========================================
+
+// ===========================================
+namespace io {
+namespace detail {
+/**
+ * Event an overlapped read is waited on by, one per thread
+ */
+struct event {
+    HANDLE handle = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+    ~event() {
+        if (handle) {
+            CloseHandle(handle);
+        }
+    }
+};
+}  // namespace detail
+}  // namespace io
+
+using namespace io;
+std::optional<size_t> io::read(HANDLE file, uint64_t offset, void* out, size_t size) {
+    thread_local const detail::event waited = {};
+
+    OVERLAPPED overlapped = {};
+    overlapped.Offset     = (DWORD)offset;
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    overlapped.hEvent     = waited.handle;
+
+    // a read may well finish right away, either way its result is there
+    // to be taken. reading at or past the end is a short read, not an error
+    DWORD read         = 0;
+    const auto started = ReadFile(file, out, (DWORD)size, nullptr, &overlapped) || (GetLastError() == ERROR_IO_PENDING);
+    if (!started || !GetOverlappedResult(file, &overlapped, &read, TRUE)) {
+        return (GetLastError() == ERROR_HANDLE_EOF) ? std::optional<size_t> {0} : std::nullopt;
+    }
+
+    return read;
+}
+
+context::context(size_t readers, size_t depth, size_t block)
+    : _depth(std::max<size_t>(depth, 1))
+    , _block(std::max<size_t>(block, 0x1000)) {
+    for (size_t i = 0; i < std::max<size_t>(readers, 1); ++i) {
+        _readers.emplace_back(&context::read, this);
+    }
+}
+
+context::~context() {
+    close();
+
+    for (auto& reader : _readers) {
+        if (reader.joinable()) {
+            reader.join();
+        }
+    }
+}
+
+void context::read() {
+    std::unique_lock lock(_mutex);
+
+    for (;;) {
+        _pushed.wait(lock, [&]() {
+            return !_blocks.empty() || _closed;
+        });
+
+        if (_blocks.empty()) {
+            return;
+        }
+
+        const auto [index, block] = _blocks.front();
+        _blocks.pop_front();
+
+        lock.unlock();
+        const auto read = io::read(block.file, block.offset, block.out, block.size);
+        lock.lock();
+
+        // extents are what's in the file, so a short read is a failed one
+        auto& [reading, left] = _reading.at(index);
+        reading.failed |= (read != block.size);
+
+        if (!--left) {
+            _done.push_back(reading);
+            _reading.erase(index);
+            _finished.notify_all();
+        }
+    }
+}
+
+void context::push(size_t index, const std::vector<extent>& extents) {
+    std::unique_lock lock(_mutex);
+
+    _taken.wait(lock, [&]() {
+        return _queued < _depth;
+    });
+
+    ++_queued;
+
+    size_t blocks = 0;
+    for (const auto& whole : extents) {
+        for (size_t offset = 0; offset < whole.size; offset += _block) {
+            _blocks.push_back({index, {whole.file, whole.offset + offset, whole.out + offset, std::min(_block, whole.size - offset)}});
+            ++blocks;
+        }
+    }
+
+    // nothing to read, it's as good as read
+    if (!blocks) {
+        _done.push_back({index, false});
+        _finished.notify_all();
+        return;
+    }
+
+    _reading.emplace(index, std::pair {job {index, false}, blocks});
+    _pushed.notify_all();
+}
+
+std::optional<job> context::pop() {
+    std::unique_lock lock(_mutex);
+
+    _finished.wait(lock, [&]() {
+        return !_done.empty() || (_closed && !_queued);
+    });
+
+    if (_done.empty()) {
+        return std::nullopt;
+    }
+
+    const auto out = _done.front();
+    _done.pop_front();
+    --_queued;
+
+    _taken.notify_all();
+    return out;
+}
+
+void context::close() {
+    {
+        std::scoped_lock lock(_mutex);
+        _closed = true;
+    }
+
+    _pushed.notify_all();
+    _finished.notify_all();
+}
+// ===========================================
@@ -0,0 +1,161 @@
+#pragma once
+
+// ===========================================
+#include <Windows.h>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <condition_variable>
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains file reading structs
+ * restrained to context
+ * 
+ */
+namespace io {
+namespace have {
+    struct extent {
+        //
+        // DATA
+        //
+
+        // file, opened for overlapped I/O
+        HANDLE file = INVALID_HANDLE_VALUE;
+
+        uint64_t offset = 0;
+        uint8_t* out    = nullptr;
+        size_t size     = 0;
+    };
+
+    struct job {
+        //
+        // DATA
+        //
+
+        size_t index = 0;
+
+        // whether any of its extents came up short
+        bool failed = false;
+    };
+}  // namespace have
+
+using namespace have;
+
+/**
+ * @brief Read up to size bytes at offset of file opened for overlapped
+ * I/O. Positional, so reads of the same handle by different threads
+ * neither race on a file pointer nor wait on each other
+ * 
+ * @param file File
+ * @param offset Offset
+ * @param out Where to read to
+ * @param size Bytes
+ * @return std::optional<size_t> Bytes read, fewer than size past the end
+ * of file. None if reading failed
+ */
+[[nodiscard]] std::optional<size_t> read(HANDLE file, uint64_t offset, void* out, size_t size);
+
+/**
+ * @brief Reads jobs of extents on a pool of threads, split in blocks so
+ * a big section is read by several of them at once. Jobs finished
+ * reading are taken in the order they finish
+ * 
+ * Only so many jobs may be pushed and not taken yet, pushing
+ * past that waits on one being taken. So reads run ahead of
+ * whoever works on what's read, but never far
+ * 
+ */
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    /**
+     * @brief Construct a new context object, starting its readers
+     * 
+     * @param readers Threads reading, so blocks in flight at once
+     * @param depth Jobs pushed and not taken allowed
+     * @param block Bytes read at once
+     */
+    [[nodiscard]] context(size_t readers, size_t depth, size_t block);
+
+    context(const context&) = delete;
+    context& operator=(const context&) = delete;
+
+    /**
+     * @brief Destroy the context object
+     * 
+     * Closes it, and waits on blocks pushed being read
+     * 
+     */
+    ~context();
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Read blocks as they're pushed, until closed and none are left
+     * 
+     */
+    void read();
+
+    //
+    // DATA
+    //
+
+    size_t _depth  = 0;
+    size_t _block  = 0;
+    size_t _queued = 0;
+    bool _closed   = false;
+
+    // blocks to read, by job index, and jobs being read, by
+    // index, with how many of their blocks are left
+    std::deque<std::pair<size_t, extent>> _blocks               = {};
+    std::unordered_map<size_t, std::pair<job, size_t>> _reading = {};
+
+    // jobs read, in the order they finished
+    std::deque<job> _done = {};
+
+    std::mutex _mutex                 = {};
+    std::condition_variable _pushed   = {};
+    std::condition_variable _finished = {};
+    std::condition_variable _taken    = {};
+    std::vector<std::thread> _readers = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    /**
+     * @brief Queue extents to be read, blocking while as many
+     * jobs as allowed are pushed and not taken
+     * 
+     * @param index User-defined job identifier, unique among those not taken
+     * @param extents Extents, their memory has to stay put until taken
+     */
+    void push(size_t index, const std::vector<extent>& extents);
+
+    /**
+     * @brief Take job whose extents are all read, blocking until one is
+     * 
+     * @return std::optional<job> Job, none once closed and every job's taken
+     */
+    [[nodiscard]] std::optional<job> pop();
+
+    /**
+     * @brief Take it that no more jobs get pushed
+     * 
+     */
+    void close();
+};
+}  // namespace io
+// ===========================================
@@ -0,0 +1,225 @@
+/**
+ * @file metrics.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Scanner metrics
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "metrics.hh"
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <fstream>
+#include "../vendor/json/json.hh"
+// ===========================================
+
+// ===========================================
+namespace metrics {
+namespace detail {
+// threads still recording, and what the ones that exited had, merged into
+// one. a pool that keeps starting threads doesn't keep growing this
+std::mutex mutex           = {};
+std::list<context> threads = {};
+context retired            = {};
+
+/**
+ * Registers a thread's metrics on its first record, and retires
+ * them as it exits
+ */
+struct slot {
+    //
+    // CONSTRUCTORS
+    //
+
+    slot() {
+        std::scoped_lock lock(mutex);
+        at = threads.emplace(threads.end());
+    }
+
+    slot(const slot&) = delete;
+    slot& operator=(const slot&) = delete;
+
+    ~slot() {
+        std::scoped_lock lock(mutex);
+        retired.merge(*at);
+        threads.erase(at);
+    }
+
+    //
+    // DATA
+    //
+
+    std::list<context>::iterator at = {};
+};
+
+inline std::string escape(std::string_view label) {
+    std::string out = {};
+    for (auto c : label) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+        } else if (c == '\n') {
+            out += "\\n";
+            continue;
+        }
+
+        out += c;
+    }
+
+    return out;
+}
+
+inline std::string labels(std::string_view key, std::string_view value, std::string_view extra = {}) {
+    std::string out = {};
+    if (!key.empty()) {
+        out += std::string {key} + "=\"" + escape(value) + '"';
+    }
+
+    if (!extra.empty()) {
+        out += (out.empty() ? "" : ",") + std::string {extra};
+    }
+
+    return out.empty() ? out : ('{' + out + '}');
+}
+}  // namespace detail
+}  // namespace metrics
+
+using namespace metrics;
+void context::add(id metric, std::string_view label, uint64_t n) {
+    auto& series = counters[metric];
+
+    // only the first record of a label allocates
+    if (auto it = series.find(label); it != series.end()) {
+        it->second += n;
+    } else {
+        series.emplace(label, n);
+    }
+}
+
+void context::observe(id metric, std::string_view label, double seconds) {
+    auto& series = histograms[metric];
+
+    auto it = series.find(label);
+    if (it == series.end()) {
+        it = series.emplace(label, histogram {}).first;
+    }
+
+    auto& [buckets, count, sum] = it->second;
+
+    const auto bucket = std::ranges::lower_bound(histogram::bounds, seconds) - histogram::bounds.begin();
+    ++buckets[bucket];
+    ++count;
+    sum += seconds;
+}
+
+void context::merge(const context& other) {
+    for (size_t metric = 0; metric < id::count; ++metric) {
+        for (const auto& [label, value] : other.counters[metric]) {
+            counters[metric][label] += value;
+        }
+
+        for (const auto& [label, value] : other.histograms[metric]) {
+            auto& out = histograms[metric][label];
+            for (size_t i = 0; i < out.buckets.size(); ++i) {
+                out.buckets[i] += value.buckets[i];
+            }
+
+            out.count += value.count;
+            out.sum += value.sum;
+        }
+    }
+}
+
+std::string context::to_prometheus() const {
+    std::stringstream out = {};
+
+    for (size_t metric = 0; metric < id::count; ++metric) {
+        const auto& [name, key, help] = detail::descriptions[metric];
+
+        out << "# HELP " << name << ' ' << help << '\n';
+
+        if (!detail::is_histogram((id)metric)) {
+            out << "# TYPE " << name << " counter\n";
+            for (const auto& [label, value] : counters[metric]) {
+                out << name << detail::labels(key, label) << ' ' << value << '\n';
+            }
+
+            continue;
+        }
+
+        // buckets are cumulative in the exposition format
+        out << "# TYPE " << name << " histogram\n";
+        for (const auto& [label, value] : histograms[metric]) {
+            uint64_t below = 0;
+            for (size_t i = 0; i < histogram::bounds.size(); ++i) {
+                below += value.buckets[i];
+
+                std::stringstream le = {};
+                le << "le=\"" << histogram::bounds[i] << '"';
+                out << name << "_bucket" << detail::labels(key, label, le.str()) << ' ' << below << '\n';
+            }
+
+            out << name << "_bucket" << detail::labels(key, label, "le=\"+Inf\"") << ' ' << value.count << '\n';
+            out << name << "_sum" << detail::labels(key, label) << ' ' << value.sum << '\n';
+            out << name << "_count" << detail::labels(key, label) << ' ' << value.count << '\n';
+        }
+    }
+
+    return out.str();
+}
+
+std::string context::to_json() const {
+    nlohmann::json json = nlohmann::json::object();
+
+    for (size_t metric = 0; metric < id::count; ++metric) {
+        auto& node = json[std::string {detail::descriptions[metric].name}];
+        node       = nlohmann::json::object();
+
+        if (!detail::is_histogram((id)metric)) {
+            for (const auto& [label, value] : counters[metric]) {
+                node[label] = value;
+            }
+
+            continue;
+        }
+
+        for (const auto& [label, value] : histograms[metric]) {
+            node[label] = {{"bounds", histogram::bounds}, {"buckets", value.buckets}, {"count", value.count}, {"sum", value.sum}};
+        }
+    }
+
+    return json.dump(4);
+}
+
+context& metrics::local() {
+    thread_local detail::slot slot = {};
+    return *slot.at;
+}
+
+context metrics::collect() {
+    std::scoped_lock lock(detail::mutex);
+
+    context out = detail::retired;
+    for (const auto& thread : detail::threads) {
+        out.merge(thread);
+    }
+
+    return out;
+}
+
+void metrics::write(const std::filesystem::path& path) {
+    const auto& merged = collect();
+
+    auto prometheus = path, json = path;
+    prometheus += ".prom";
+    json += ".json";
+
+    std::ofstream(prometheus) << merged.to_prometheus();
+    std::ofstream(json) << merged.to_json() << '\n';
+}
+// ===========================================
@@ -0,0 +1,191 @@
+#pragma once
+
+// ===========================================
+#include <map>
+#include <array>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <filesystem>
+#include <cstdint>
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains scanner metrics structs
+ * restrained to context
+ * 
+ * Recording is compiled in with ALTDUMPER_METRICS, without it every
+ * record call is an empty inline function and timers hold nothing
+ * 
+ */
+namespace metrics {
+//
+// ENUMS
+//
+
+enum id : uint8_t {
+    // counters
+    bytes_scanned,
+    candidates,
+    matches,
+    rejected,
+    cache_hits,
+    cache_misses,
+    // histograms, seconds
+    entry_seconds,
+    load_seconds,
+    count
+};
+
+namespace have {
+    struct description {
+        //
+        // DATA
+        //
+
+        std::string_view name  = {};
+        std::string_view label = {};
+        std::string_view help  = {};
+    };
+
+    struct histogram {
+        //
+        // DATA
+        //
+
+        // upper bounds of buckets, seconds. the last bucket is +Inf
+        static constexpr std::array<double, 12> bounds = {0.00001, 0.00005, 0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5};
+
+        std::array<uint64_t, bounds.size() + 1> buckets = {};
+        uint64_t count                                  = 0;
+        double sum                                      = 0;
+    };
+}  // namespace have
+
+namespace detail {
+    // indexed by id
+    constexpr have::description descriptions[id::count] = {
+        {"altdumper_bytes_scanned_total", "section", "Bytes scanned through, per section"},
+        {"altdumper_candidates_total", "section", "Positions the engine picked out and checked in full, per section"},
+        {"altdumper_matches_total", "section", "Positions which matched in full, per section"},
+        {"altdumper_rejected_total", "section", "Patterns a section's q-gram filter rejected without a scan"},
+        {"altdumper_cache_hits_total", "cache", "Lookups served from a cache, per cache"},
+        {"altdumper_cache_misses_total", "cache", "Lookups a cache couldn't serve, per cache"},
+        {"altdumper_entry_duration_seconds", "type", "Time taken resolving an entry, per entry type"},
+        {"altdumper_module_load_duration_seconds", "", "Time taken reading a module's headers and hashing it"}};
+
+    constexpr auto is_histogram(id metric) {
+        return metric >= id::entry_seconds;
+    }
+}  // namespace detail
+
+using namespace have;
+/**
+ * @brief Metrics of one thread. Every thread records into its own,
+ * without locks, and they're merged once the threads are done
+ * 
+ */
+struct context {
+    //
+    // DATA
+    //
+
+    // per metric, value per label value
+    template<typename T>
+    using series = std::map<std::string, T, std::less<>>;
+
+    std::array<series<uint64_t>, id::count> counters    = {};
+    std::array<series<histogram>, id::count> histograms = {};
+
+    //
+    // UTILITY
+    //
+
+    void add(id metric, std::string_view label, uint64_t n);
+    void observe(id metric, std::string_view label, double seconds);
+
+    /**
+     * @brief Add other's values to ours
+     * 
+     * @param other Metrics
+     */
+    void merge(const context& other);
+
+    //
+    // EXPORT
+    //
+
+    /**
+     * @brief Format as Prometheus text exposition
+     * 
+     */
+    [[nodiscard]] std::string to_prometheus() const;
+
+    /**
+     * @brief Format as JSON, metric name to label value to value
+     * 
+     */
+    [[nodiscard]] std::string to_json() const;
+};
+
+/**
+ * @brief Metrics of the calling thread, registered on first use. They're
+ * merged into what's kept for exited threads as it exits
+ * 
+ */
+[[nodiscard]] context& local();
+
+/**
+ * @brief Merge metrics of every thread. Threads which recorded have to be done
+ * 
+ */
+[[nodiscard]] context collect();
+
+/**
+ * @brief Write merged metrics as Prometheus text and as JSON
+ * 
+ * @param path Path without extension, .prom and .json get appended
+ */
+void write(const std::filesystem::path& path);
+
+#ifdef ALTDUMPER_METRICS
+inline void add(id metric, std::string_view label, uint64_t n = 1) {
+    local().add(metric, label, n);
+}
+
+inline void observe(id metric, std::string_view label, double seconds) {
+    local().observe(metric, label, seconds);
+}
+
+struct timer {
+    //
+    // DATA
+    //
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    //
+    // UTILITY
+    //
+
+    inline auto get_elapsed() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+#else
+inline void add(id, std::string_view, uint64_t = 1) {}
+inline void observe(id, std::string_view, double) {}
+
+struct timer {
+    //
+    // UTILITY
+    //
+
+    constexpr auto get_elapsed() const {
+        return 0.0;
+    }
+};
+#endif
+}  // namespace metrics
+// ===========================================
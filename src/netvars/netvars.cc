@@ -0,0 +1,129 @@
+/**
+ * @file netvars.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Source engine networked variables
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "netvars.hh"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+// ===========================================
+
+// ===========================================
+namespace netvars {
+namespace detail {
+// x86 layouts, as of the Source SDK
+
+// ClientClass { create, create_event, network name, table, next, id }
+constexpr uint32_t class_name  = 0x8;
+constexpr uint32_t class_table = 0xC;
+constexpr uint32_t class_size  = 0x18;
+
+// RecvTable { props, prop count, decoder, name, ... }
+constexpr uint32_t table_props = 0x0;
+constexpr uint32_t table_count = 0x4;
+constexpr uint32_t table_name  = 0xC;
+
+// RecvProp { name, type, ..., data table at 0x28, offset at 0x2C, ... }
+constexpr uint32_t prop_name   = 0x0;
+constexpr uint32_t prop_table  = 0x28;
+constexpr uint32_t prop_offset = 0x2C;
+constexpr uint32_t prop_size   = 0x3C;
+
+// biggest tables ship a few hundred props
+constexpr uint32_t max_props = 0x1000;
+}  // namespace detail
+}  // namespace netvars
+
+using namespace netvars;
+context::context(const modules::context& module)
+    : _module(&module) {
+    if (module.get_architecture() != modules::context::architecture::x86) {
+        throw std::runtime_error("Netvar scanning is only supported on x86 images.");
+    }
+
+    if (!module.get_sections().contains(".data")) {
+        return;
+    }
+
+    module.page_in(".data");
+
+    // a ClientClass is anything pointer aligned in .data with a network
+    // name, and a table whose name starts like every table's does
+    const auto& data = module.get_section(".data");
+    for (auto i = data.start; (i + detail::class_size) <= (data.start + data.size); i += sizeof(uint32_t)) {
+        const auto base = module.get_image_base() + i;
+
+        const auto name  = module.read_name(module.read<uint32_t>(base + detail::class_name).value_or(0));
+        const auto table = module.read<uint32_t>(base + detail::class_table).value_or(0);
+        if (name.empty() || !module.read_name(module.read<uint32_t>(table + detail::table_name).value_or(0)).starts_with("DT_")) {
+            continue;
+        }
+
+        _classes.emplace(name, module.read_name(module.read<uint32_t>(table + detail::table_name).value()));
+        walk(table);
+    }
+}
+
+const std::vector<prop>& context::walk(uint64_t table) {
+    // tables nest and repeat, each one is only ever walked once.
+    // elements stay put as the map grows, and a table which nests
+    // itself gets back whatever of it is done so far
+    if (auto found = _walked.find(table); found != _walked.end()) {
+        return found->second;
+    }
+
+    const auto& module = *_module;
+    auto& out          = _walked[table];
+
+    const auto name  = module.read_name(module.read<uint32_t>(table + detail::table_name).value_or(0));
+    const auto props = module.read<uint32_t>(table + detail::table_props).value_or(0);
+    const auto count = std::min(module.read<uint32_t>(table + detail::table_count).value_or(0), detail::max_props);
+
+    if (!name.empty()) {
+        _tables.emplace(name, table);
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto prop = (uint64_t)props + (i * detail::prop_size);
+
+        // array elements are named by index, the array itself has the offset
+        const auto field = module.read_name(module.read<uint32_t>(prop + detail::prop_name).value_or(0));
+        if (field.empty() || std::isdigit((unsigned char)field.front())) {
+            continue;
+        }
+
+        const auto offset = module.read<uint32_t>(prop + detail::prop_offset).value_or(0);
+        const auto nested = module.read<uint32_t>(prop + detail::prop_table).value_or(0);
+
+        out.push_back({field, offset});
+
+        if (!nested || !module.read_name(module.read<uint32_t>(nested + detail::table_name).value_or(0)).starts_with("DT_")) {
+            continue;
+        }
+
+        // copied, as out may be what's being walked
+        const auto flattened = walk(nested);
+        for (const auto& [inner_field, inner_offset] : flattened) {
+            out.push_back({inner_field, offset + inner_offset});
+        }
+    }
+
+    return out;
+}
+
+const std::vector<prop>* context::find_table(std::string_view name) const {
+    if (auto found = _tables.find(name); found != _tables.end()) {
+        return &_walked.at(found->second);
+    }
+
+    return nullptr;
+}
+// ===========================================
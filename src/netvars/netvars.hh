@@ -0,0 +1,103 @@
+#pragma once
+
+// ===========================================
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include "../ctx/ctx.hh"
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains Source engine networked variable structs
+ * restrained to context
+ * 
+ */
+namespace netvars {
+namespace have {
+    struct prop {
+        //
+        // DATA
+        //
+
+        std::string_view name = {};
+
+        // relative to the start of the table walked
+        uint32_t offset = 0;
+    };
+}  // namespace have
+
+/**
+ * @brief Every RecvTable reachable from the ClientClasses found in a module's
+ * data, read straight out of the image. Each table is walked once and its
+ * props, nested tables' included, are kept flattened for the tables
+ * which nest it
+ * 
+ * Source builds which fill these in from dynamic initializers only have
+ * what's statically initialized to show for it on disk, their complete
+ * graph is in the memory of a running process
+ * 
+ */
+using namespace have;
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object, walking module
+     * 
+     * @param module x86 module, has to outlive the walk, names point into it
+     */
+    [[nodiscard]] context(const modules::context& module);
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Flatten table and every table nested in it, once
+     * 
+     * @param table Image address of RecvTable
+     * @return const std::vector<prop>& Props, offsets relative to table
+     */
+    const std::vector<prop>& walk(uint64_t table);
+
+    //
+    // DATA
+    //
+
+    const modules::context* _module = nullptr;
+
+    // by name, and by address once walked
+    std::unordered_map<std::string_view, uint64_t> _tables          = {};
+    std::unordered_map<uint64_t, std::vector<prop>> _walked         = {};
+    std::unordered_map<std::string_view, std::string_view> _classes = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    /**
+     * @brief Network name of every ClientClass found, to its table's name
+     * 
+     */
+    [[nodiscard]] inline const auto& get_classes() const {
+        return _classes;
+    }
+
+    /**
+     * @brief Find flattened table
+     * 
+     * @param name Table name, like DT_BasePlayer
+     * @return const std::vector<prop>* Props, nullptr if there's no such table
+     */
+    [[nodiscard]] const std::vector<prop>* find_table(std::string_view name) const;
+};
+}  // namespace netvars
+// ===========================================
@@ -0,0 +1,277 @@
+/**
+ * @file pattern.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Pattern compilation
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "pattern.hh"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <bit>
+// ===========================================
+
+// ===========================================
+namespace pattern {
+namespace detail {
+inline std::optional<uint8_t> from_hex(char digit) {
+    if (digit >= '0' && digit <= '9') {
+        return digit - '0';
+    }
+
+    if (digit >= 'a' && digit <= 'f') {
+        return digit - 'a' + 10;
+    }
+
+    if (digit >= 'A' && digit <= 'F') {
+        return digit - 'A' + 10;
+    }
+
+    return std::nullopt;
+}
+
+inline uint8_t byte_from_hex(std::string_view token) {
+    if (token.empty() || token.size() > 2) {
+        throw std::runtime_error("Invalid pattern byte \"" + std::string {token} + "\".");
+    }
+
+    uint8_t out = 0;
+    for (auto digit : token) {
+        auto value = from_hex(digit);
+        if (!value.has_value()) {
+            throw std::runtime_error("Invalid pattern byte \"" + std::string {token} + "\".");
+        }
+
+        out = (uint8_t)((out << 4) | value.value());
+    }
+
+    return out;
+}
+
+// common in code, so a poor pick to look for first
+constexpr uint8_t common_bytes[] = {0x00, 0xFF, 0xCC, 0x8B, 0x89, 0xE8, 0x48, 0x0F};
+
+// below this, Horspool's average skip doesn't pay for its table
+// lookups over memchr, which checks a vector of bytes per step
+constexpr size_t horspool_run = 8;
+}  // namespace detail
+}  // namespace pattern
+
+using namespace pattern;
+context::context(std::string_view signature, std::pmr::memory_resource* scratch)
+    : _value(scratch)
+    , _mask(scratch)
+    , _sets(scratch)
+    , _table(scratch) {
+    // can't have more bytes than 1 + spaces
+    _value.reserve((signature.size() / 2) + 1 + sizeof(uint64_t));
+    _mask.reserve(_value.capacity());
+
+    while (!signature.empty()) {
+        const auto begin = signature.find_first_not_of(" \t");
+        if (begin == std::string_view::npos) {
+            break;
+        }
+
+        const auto end   = std::min(signature.find_first_of(" \t", begin), signature.size());
+        const auto token = signature.substr(begin, end - begin);
+        signature.remove_prefix(end);
+
+        if (token == "?" || token == "??") {
+            push(0x00, 0x00);
+        } else if (token.front() == '[' && token.back() == ']') {
+            std::bitset<256> bytes = {};
+
+            // items are single bytes or inclusive ranges, comma separated
+            auto items = token.substr(1, token.size() - 2);
+            while (!items.empty()) {
+                const auto comma = std::min(items.find(','), items.size());
+                const auto item  = items.substr(0, comma);
+                items.remove_prefix(std::min(comma + 1, items.size()));
+
+                const auto dash = item.find('-');
+                const auto low  = detail::byte_from_hex(item.substr(0, dash));
+                const auto high = (dash == std::string_view::npos) ? low : detail::byte_from_hex(item.substr(dash + 1));
+
+                for (auto byte = (size_t)low; byte <= high; ++byte) {
+                    bytes.set(byte);
+                }
+            }
+
+            if (bytes.none()) {
+                throw std::runtime_error("Empty pattern set \"" + std::string {token} + "\".");
+            }
+
+            // bits every member agrees on make the mask, which
+            // is exact when the set spans every other combination
+            uint8_t all = 0xFF, any = 0x00;
+            for (size_t byte = 0; byte < bytes.size(); ++byte) {
+                if (bytes.test(byte)) {
+                    all &= (uint8_t)byte;
+                    any |= (uint8_t)byte;
+                }
+            }
+
+            const auto mask = (uint8_t)~(all ^ any);
+            if (bytes.count() != ((size_t)1 << (8 - std::popcount(mask)))) {
+                _sets.push_back({_size, bytes});
+            }
+
+            push(all & mask, mask);
+        } else if (token.size() == 2 && (token[0] == '?' || token[1] == '?')) {
+            // nibble wildcard, the other nibble is exact
+            const auto high = (token[0] == '?') ? std::optional<uint8_t> {0} : detail::from_hex(token[0]);
+            const auto low  = (token[1] == '?') ? std::optional<uint8_t> {0} : detail::from_hex(token[1]);
+            if (!high.has_value() || !low.has_value()) {
+                throw std::runtime_error("Invalid pattern byte \"" + std::string {token} + "\".");
+            }
+
+            push((uint8_t)((high.value() << 4) | low.value()), (uint8_t)(((token[0] == '?') ? 0x00 : 0xF0) | ((token[1] == '?') ? 0x00 : 0x0F)));
+        } else {
+            push(detail::byte_from_hex(token), 0xFF);
+        }
+    }
+
+    finish();
+}
+
+context::context(const uint8_t* bytes, size_t size, std::pmr::memory_resource* scratch)
+    : _value(scratch)
+    , _mask(scratch)
+    , _sets(scratch)
+    , _table(scratch) {
+    _value.reserve(size + sizeof(uint64_t));
+    _mask.reserve(_value.capacity());
+
+    for (size_t i = 0; i < size; ++i) {
+        push(bytes[i], 0xFF);
+    }
+
+    finish();
+}
+
+bool context::supports(engine which) const {
+    switch (which) {
+        case engine::linear:
+            return true;
+        case engine::anchored:
+            return _anchor.has_value();
+        case engine::horspool:
+            return _run.size > 0;
+        case engine::shift_or:
+            return _size <= 64;
+    }
+
+    return false;
+}
+
+void context::set_engine(engine which) {
+    if (!supports(which)) {
+        throw std::runtime_error("Pattern can't be scanned with that engine.");
+    }
+
+    _engine = which;
+}
+
+void context::push(uint8_t value, uint8_t mask) {
+    _value.push_back(value & mask);
+    _mask.push_back(mask);
+    ++_size;
+}
+
+void context::finish() {
+    // tail of the last word never matters
+    while (_value.size() % sizeof(uint64_t)) {
+        _value.push_back(0x00);
+        _mask.push_back(0x00);
+    }
+
+    for (size_t i = 0; i < _size; ++i) {
+        if (_mask[i] != 0xFF) {
+            continue;
+        }
+
+        if (!_anchor.has_value()) {
+            _anchor = anchor {i, _value[i]};
+        }
+
+        if (std::ranges::find(detail::common_bytes, _value[i]) == std::end(detail::common_bytes)) {
+            _anchor = anchor {i, _value[i]};
+            break;
+        }
+    }
+
+    for (size_t i = 0, size = 0; i < _size; ++i) {
+        size = (_mask[i] == 0xFF) ? (size + 1) : 0;
+        if (size > _run.size) {
+            _run = run {i + 1 - size, size};
+        }
+    }
+
+    if (_run.size) {
+        // shifts are bytes, runs past that just shift a little less than they could
+        const auto size = std::min<size_t>(_run.size, 0xFF);
+        const auto end  = _run.index + _run.size;
+
+        _run.index = end - size;
+        _run.size  = size;
+
+        _shifts.fill((uint8_t)size);
+        for (size_t i = _run.index; i < (end - 1); ++i) {
+            _shifts[_value[i]] = (uint8_t)(end - 1 - i);
+        }
+    }
+
+    if (_run.size >= detail::horspool_run) {
+        _engine = engine::horspool;
+    } else if (_anchor.has_value()) {
+        _engine = engine::anchored;
+    } else if (_size <= 64) {
+        _engine = engine::shift_or;
+    }
+
+    // bits past the pattern's end stay set, they're shifted out
+    // before they could ever reach the last one
+    const auto words = get_words();
+    _table.assign(256 * words, ~0ull);
+
+    for (size_t byte = 0; byte < 256; ++byte) {
+        for (size_t i = 0; i < _size; ++i) {
+            if ((byte & _mask[i]) != _value[i]) {
+                continue;
+            }
+
+            _table[(byte * words) + (i / 64)] &= ~(1ull << (i % 64));
+        }
+    }
+
+    for (const auto& [index, bytes] : _sets) {
+        for (size_t byte = 0; byte < 256; ++byte) {
+            if (!bytes.test(byte)) {
+                _table[(byte * words) + (index / 64)] |= (1ull << (index % 64));
+            }
+        }
+    }
+}
+
+std::string_view pattern::describe(context::engine which) {
+    switch (which) {
+        case context::engine::linear:
+            return "linear";
+        case context::engine::shift_or:
+            return "shift-or";
+        case context::engine::anchored:
+            return "anchored";
+        case context::engine::horspool:
+            return "horspool";
+        default:
+            return "unknown";
+    }
+}
+// ===========================================
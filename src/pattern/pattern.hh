@@ -0,0 +1,302 @@
+#pragma once
+
+// ===========================================
+#include <vector>
+#include <array>
+#include <bitset>
+#include <algorithm>
+#include <optional>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <memory_resource>
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains pattern compilation structs
+ * restrained to context
+ * 
+ */
+namespace pattern {
+namespace have {
+    struct set {
+        //
+        // DATA
+        //
+
+        size_t index           = 0;
+        std::bitset<256> bytes = {};
+    };
+
+    struct anchor {
+        //
+        // DATA
+        //
+
+        size_t index = 0;
+        uint8_t byte = 0;
+    };
+
+    struct run {
+        //
+        // DATA
+        //
+
+        size_t index = 0;
+        size_t size  = 0;
+    };
+}  // namespace have
+
+/**
+ * @brief Compiled pattern. Every byte is checked as (byte & mask) == value,
+ * 8 at a time. Byte sets a mask can't express exactly are filtered by their
+ * common bits first, then checked against the set itself
+ * 
+ * Syntax, whitespace separated:
+ * - AB: exact byte
+ * - ? or ??: any byte
+ * - ?5, 8?: nibble wildcards
+ * - [80-8F], [01,05,10-1F]: byte sets, of single bytes and ranges
+ */
+using namespace have;
+struct context {
+    //
+    // ENUMS
+    //
+
+    /**
+     * @brief How candidates are found, picked per pattern shape
+     * 
+     */
+    enum engine : uint8_t {
+        // every position, no exact byte to look for
+        linear,
+        // no exact byte either, but fits one Shift-Or register
+        shift_or,
+        // memchr for one exact byte
+        anchored,
+        // Horspool skips over the longest exact run
+        horspool
+    };
+
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object from an IDA-style string
+     * 
+     * @param signature Pattern string
+     * @param scratch Where the compiled form is allocated from
+     */
+    [[nodiscard]] context(std::string_view signature, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+    /**
+     * @brief Construct a new context object matching bytes exactly
+     * 
+     * @param bytes Bytes to match
+     * @param size Byte count
+     * @param scratch Where the compiled form is allocated from
+     */
+    [[nodiscard]] context(const uint8_t* bytes, size_t size, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Append byte to pattern
+     * 
+     * @param value Value, once masked
+     * @param mask Bits which have to match
+     */
+    void push(uint8_t value, uint8_t mask);
+
+    /**
+     * @brief Pad words, pick anchor and engine, build the Shift-Or table.
+     * Done once every byte is pushed
+     * 
+     */
+    void finish();
+
+    //
+    // DATA
+    //
+
+    size_t _size = 0;
+
+    std::pmr::vector<uint8_t> _value = {};
+    std::pmr::vector<uint8_t> _mask  = {};
+    std::pmr::vector<set> _sets      = {};
+
+    std::optional<anchor> _anchor = std::nullopt;
+
+    // longest run of exact bytes, and how far each byte at its
+    // end lets Horspool shift
+    run _run                         = {};
+    std::array<uint8_t, 256> _shifts = {};
+
+    engine _engine = engine::linear;
+
+    // Shift-Or table, get_words() per byte value. a bit is clear
+    // where that byte satisfies the pattern at the bit's index
+    std::pmr::vector<uint64_t> _table = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    inline auto get_size() const {
+        return _size;
+    }
+
+    /**
+     * @brief Bytes read by matches(), a whole number of words
+     * 
+     */
+    inline auto get_width() const {
+        return _value.size();
+    }
+
+    [[nodiscard]] inline const auto& get_value() const {
+        return _value;
+    }
+
+    [[nodiscard]] inline const auto& get_mask() const {
+        return _mask;
+    }
+
+    [[nodiscard]] inline const auto& get_sets() const {
+        return _sets;
+    }
+
+    /**
+     * @brief Exact byte worth looking for first, if the pattern has one
+     * 
+     */
+    [[nodiscard]] inline const auto& get_anchor() const {
+        return _anchor;
+    }
+
+    [[nodiscard]] inline const auto& get_run() const {
+        return _run;
+    }
+
+    inline auto get_shift(uint8_t byte) const {
+        return _shifts[byte];
+    }
+
+    inline auto get_engine() const {
+        return _engine;
+    }
+
+    /**
+     * @brief Whether the pattern has what engine needs. Every engine
+     * finds the same matches, in the same order, when it does
+     * 
+     * @param which Engine
+     */
+    [[nodiscard]] bool supports(engine which) const;
+
+    /**
+     * @brief Scan with engine instead of the one picked for the pattern's shape
+     * 
+     * @param which Supported engine
+     */
+    void set_engine(engine which);
+
+    /**
+     * @brief 64 bit words a Shift-Or state needs for this pattern
+     * 
+     */
+    inline auto get_words() const {
+        return (_size + 63) / 64;
+    }
+
+    /**
+     * @brief Shift-Or mask of a byte, get_words() long
+     * 
+     * @param byte Byte
+     */
+    [[nodiscard]] inline auto get_table(uint8_t byte) const {
+        return &_table[byte * get_words()];
+    }
+
+    /**
+     * @brief Whether the pattern is only exact bytes and whole wildcards
+     * 
+     */
+    inline auto is_plain() const {
+        return _sets.empty() && std::all_of(_mask.begin(), _mask.end(), [](uint8_t mask) {
+                   return (mask == 0x00) || (mask == 0xFF);
+               });
+    }
+
+    /**
+     * @brief Match set constrained bytes at address
+     * 
+     * @param at Address
+     */
+    inline auto matches_sets(const uint8_t* at) const {
+        for (const auto& [index, bytes] : _sets) {
+            if (!bytes.test(at[index])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Match at address, reading get_width() bytes
+     * 
+     * @param at Address
+     */
+    inline auto matches(const uint8_t* at) const {
+        for (size_t i = 0; i < _value.size(); i += sizeof(uint64_t)) {
+            uint64_t bytes, value, mask;
+            std::memcpy(&bytes, at + i, sizeof(uint64_t));
+            std::memcpy(&value, &_value[i], sizeof(uint64_t));
+            std::memcpy(&mask, &_mask[i], sizeof(uint64_t));
+
+            if ((bytes & mask) != value) {
+                return false;
+            }
+        }
+
+        return matches_sets(at);
+    }
+
+    /**
+     * @brief Match at address, reading get_size() bytes
+     * 
+     * @param at Address
+     */
+    inline auto matches_bytewise(const uint8_t* at) const {
+        for (size_t i = 0; i < _size; ++i) {
+            if ((at[i] & _mask[i]) != _value[i]) {
+                return false;
+            }
+        }
+
+        return matches_sets(at);
+    }
+};
+
+// every engine, in the order they're checked against each other
+constexpr std::array engines = {context::engine::linear, context::engine::anchored, context::engine::horspool, context::engine::shift_or};
+
+/**
+ * @brief Get what an engine reads as in output
+ * 
+ * @param which Engine
+ * @return std::string_view Name
+ */
+[[nodiscard]] std::string_view describe(context::engine which);
+}  // namespace pattern
+// ===========================================
@@ -0,0 +1,310 @@
+/**
+ * @file plan.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Cost model driven module scan planning
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "plan.hh"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <iomanip>
+// ===========================================
+
+// ===========================================
+namespace plan {
+namespace detail {
+// bytes per second, roughly, of a scan by each engine, indexed by engine
+constexpr double scan_rates[] = {0.4e9, 1.2e9, 2e9, 2.5e9};
+
+// a scan for references to one address, and a pass indexing references
+// to any of a set of them. a set is worth indexing from 3 addresses on
+constexpr double reference_rate = 2.5e9;
+constexpr double index_rate     = 1e9;
+
+// RTTI, netvars and interface registries, walked once per module
+constexpr double walk_rate = 0.25e9;
+
+// what's a lookup once its scan is done
+constexpr double lookup = 1e-6;
+
+// how much a new timing moves the average
+constexpr double weight = 0.5;
+
+constexpr std::string_view kinds[]   = {"signature", "string-search", "procedure", "convar", "vtable", "interface", "netvar"};
+constexpr std::string_view batches[] = {"signatures", "references"};
+
+// how long an entry that's not timed again is kept for
+constexpr int64_t max_age = 30 * 24 * 60 * 60;
+
+inline auto get_size(const modules::context& module, std::string_view section) {
+    return module.get_sections().contains(section) ? (double)module.get_section(section).size : 0.0;
+}
+}  // namespace detail
+}  // namespace plan
+
+using namespace plan;
+uint64_t plan::identify(uint64_t module, kind type, size_t entry) {
+    // splitmix64's finalizer over each part in turn
+    const auto mix = [](uint64_t value) {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+        return value ^ (value >> 31);
+    };
+
+    return mix(mix(mix(module) ^ type) ^ entry);
+}
+
+std::unordered_map<uint64_t, history::timing> history::read(const std::filesystem::path& path, int64_t now) {
+    std::unordered_map<uint64_t, timing> out = {};
+    if (path.empty()) {
+        return out;
+    }
+
+    std::ifstream file(path);
+
+    // a hex id, when it was last timed, then seconds, a line each
+    uint64_t id  = 0;
+    timing timed = {};
+    while (file >> std::hex >> id >> std::dec >> timed.timed >> timed.seconds) {
+        if ((now - timed.timed) <= detail::max_age) {
+            out[id] = timed;
+        }
+    }
+
+    return out;
+}
+
+history::history(const std::filesystem::path& path)
+    : _path(path)
+    , _now(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count()) {
+    _timings = read(path, _now);
+}
+
+std::optional<double> history::find(uint64_t id) const {
+    std::scoped_lock lock(_mutex);
+
+    if (auto found = _timings.find(id); found != _timings.end()) {
+        return found->second.seconds;
+    }
+
+    return std::nullopt;
+}
+
+void history::record(uint64_t id, double seconds) {
+    std::scoped_lock lock(_mutex);
+
+    auto [it, inserted] = _timings.try_emplace(id, timing {seconds});
+    if (!inserted) {
+        it->second.seconds += detail::weight * (seconds - it->second.seconds);
+    }
+
+    it->second.timed    = _now;
+    it->second.recorded = true;
+}
+
+void history::save() const {
+    if (_path.empty()) {
+        return;
+    }
+
+    std::scoped_lock lock(_mutex);
+
+    // worker processes save theirs as they go. they take turns, each reading
+    // what's on file over and putting what it timed on top, so none drops
+    // what another saved since it started
+    const auto name = "Local\\altdumper-timings-" + std::to_string(std::hash<std::wstring> {}(_path.wstring()));
+    const auto turn = CreateMutexA(nullptr, FALSE, name.c_str());
+    if (turn != nullptr) {
+        WaitForSingleObject(turn, INFINITE);
+    }
+
+    auto merged = read(_path, _now);
+    for (const auto& [id, timed] : _timings) {
+        if (timed.recorded) {
+            merged[id] = timed;
+        }
+    }
+
+    // a history that can't be written to only costs the next run its estimates.
+    // each writes its own file and renames it over, and a reader only ever
+    // sees one of them whole
+    auto temporary = _path;
+    temporary += '.' + std::to_string(GetCurrentProcessId()) + ".tmp";
+
+    auto written = false;
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        for (const auto& [id, timed] : merged) {
+            file << std::hex << id << std::dec << ' ' << timed.timed << ' ' << timed.seconds << '\n';
+        }
+
+        written = file.good();
+    }
+
+    std::error_code error = {};
+    if (written) {
+        std::filesystem::rename(temporary, _path, error);
+    }
+
+    if (!written || error) {
+        std::filesystem::remove(temporary, error);
+    }
+
+    if (turn != nullptr) {
+        ReleaseMutex(turn);
+        CloseHandle(turn);
+    }
+}
+
+double context::estimate(const modules::context& module, const entry& planned, bool walked) const {
+    const auto size = detail::get_size(module, planned.section);
+
+    switch (planned.type) {
+        case kind::signature: {
+            return size / detail::scan_rates[planned.pattern->get_engine()];
+        }
+        case kind::string_search: {
+            return size / detail::reference_rate;
+        }
+        case kind::convar: {
+            // the first reference is rarely the constructor's
+            return (2 * size) / detail::reference_rate;
+        }
+        case kind::vtable: {
+            return walked ? detail::lookup : ((size + detail::get_size(module, ".data")) / detail::walk_rate);
+        }
+        case kind::registration:
+        case kind::netvar: {
+            return walked ? detail::lookup : (size / detail::walk_rate);
+        }
+        default: {
+            return detail::lookup;
+        }
+    }
+}
+
+context::context(const modules::context& module, std::vector<entry> entries, const history& past)
+    : _entries(std::move(entries)) {
+    // walks are shared, the first entry of each kind pays for its walk
+    bool walked[kind::netvar + 1] = {};
+    for (auto& planned : _entries) {
+        if (const auto seconds = past.find(planned.id); seconds.has_value()) {
+            planned.cost     = seconds.value();
+            planned.measured = true;
+        } else {
+            planned.cost = estimate(module, planned, walked[planned.type]);
+        }
+
+        walked[planned.type] = true;
+    }
+
+    std::ranges::stable_sort(_entries, std::greater {}, &entry::cost);
+
+    // by section, what could be batched
+    std::map<std::string_view, std::vector<size_t>> signatures = {};
+    std::map<std::string_view, std::vector<size_t>> references = {};
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const auto& planned = _entries[i];
+        if (planned.section.empty() || !module.get_sections().contains(planned.section) || module.is_streamed(planned.section)) {
+            continue;
+        }
+
+        if (planned.type == kind::signature) {
+            signatures[planned.section].push_back(i);
+        } else if (planned.type == kind::string_search || planned.type == kind::convar) {
+            references[planned.section].push_back(i);
+        }
+    }
+
+    const auto alone = [&](const std::vector<size_t>& batched) {
+        double out = 0;
+        for (auto i : batched) {
+            out += _entries[i].cost;
+        }
+
+        return out;
+    };
+
+    // a batched pass checks as many candidates as the scans it replaces,
+    // it saves reading the section over for each of them
+    for (auto& [section, batched] : signatures) {
+        if (batched.size() > 1) {
+            const auto cost = alone(batched);
+            _passes.push_back({batch::signatures, section, std::move(batched), cost, cost});
+        }
+    }
+
+    // indexing references costs more per byte than a scan for one address,
+    // it's only done when it's cheaper than the scans it replaces
+    for (auto& [section, batched] : references) {
+        const auto cost = detail::get_size(module, section) / detail::index_rate;
+        if (const auto apart = alone(batched); cost < apart) {
+            _passes.push_back({batch::references, section, std::move(batched), cost, apart});
+        }
+    }
+
+    std::ranges::stable_sort(_passes, std::greater {}, &pass::cost);
+}
+
+std::vector<double> context::run(const modules::context& module, std::pmr::memory_resource* scratch) const {
+    std::vector<double> shares(_entries.size(), 0.0);
+
+    for (const auto& planned : _passes) {
+        const auto begin = std::chrono::steady_clock::now();
+
+        if (planned.type == batch::signatures) {
+            std::vector<std::pair<const pattern::context*, size_t>> wanted = {};
+            for (auto i : planned.entries) {
+                wanted.emplace_back(_entries[i].pattern, _entries[i].nth_match);
+            }
+
+            module.scan_signatures(wanted, planned.section);
+        } else {
+            std::vector<std::string_view> strings = {};
+            for (auto i : planned.entries) {
+                strings.push_back(_entries[i].string);
+            }
+
+            module.scan_references(strings, planned.section, scratch);
+        }
+
+        // entries it did the scanning of are timed as lookups, they
+        // carry their share of it into the history
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        for (auto i : planned.entries) {
+            shares[i] += seconds / planned.entries.size();
+        }
+    }
+
+    return shares;
+}
+
+void context::explain(std::ostream& out, std::string_view name) const {
+    const auto ms = [](double seconds) {
+        return seconds * 1000;
+    };
+
+    out << std::fixed << std::setprecision(3) << "[plan] " << name << '\n';
+
+    for (const auto& planned : _passes) {
+        out << "  pass " << detail::batches[planned.type] << " in " << planned.section << ", " << planned.entries.size() << " entries, ~" << ms(planned.cost) << "ms (~" << ms(planned.alone) << "ms apart)\n";
+    }
+
+    for (const auto& planned : _entries) {
+        out << "  " << detail::kinds[planned.type] << ' ' << planned.name;
+        if (!planned.section.empty()) {
+            out << " in " << planned.section;
+        }
+
+        out << ", ~" << ms(planned.cost) << "ms " << (planned.measured ? "measured" : "estimated") << '\n';
+    }
+}
+// ===========================================
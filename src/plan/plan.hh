@@ -0,0 +1,265 @@
+#pragma once
+
+// ===========================================
+#include <vector>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <unordered_map>
+#include <filesystem>
+#include <mutex>
+#include <ostream>
+#include "../ctx/ctx.hh"
+#include "../pattern/pattern.hh"
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains module scan planning structs
+ * restrained to context
+ * 
+ */
+namespace plan {
+//
+// ENUMS
+//
+
+enum kind : uint8_t {
+    signature,
+    string_search,
+    procedure,
+    convar,
+    vtable,
+    registration,
+    netvar
+};
+
+enum batch : uint8_t {
+    // one chunked pass over a section for several patterns
+    signatures,
+    // one pass over a section for references to several strings
+    references
+};
+
+namespace have {
+    struct entry {
+        //
+        // DATA
+        //
+
+        kind type = kind::signature;
+
+        // the caller's own index of it, carried through planning
+        size_t index = 0;
+
+        std::string_view name = {};
+
+        // identifies it to past timings, across runs
+        uint64_t id = 0;
+
+        // scanned, pattern for signatures, string for string
+        // searches and convars. empty where there's none
+        std::string_view section        = {};
+        const pattern::context* pattern = nullptr;
+        size_t nth_match                = 0;
+        std::string_view string         = {};
+
+        // seconds, measured when it's from past runs
+        double cost   = 0;
+        bool measured = false;
+    };
+
+    struct pass {
+        //
+        // DATA
+        //
+
+        batch type               = batch::signatures;
+        std::string_view section = {};
+
+        // indices of the entries it does the scanning of
+        std::vector<size_t> entries = {};
+
+        // seconds, and what its entries would take scanning on their own
+        double cost  = 0;
+        double alone = 0;
+    };
+}  // namespace have
+
+using namespace have;
+
+/**
+ * @brief Id of an entry to past timings, the same across runs
+ * 
+ * @param module Content hash of module it's of
+ * @param type Entry kind
+ * @param entry Hash of entry's config
+ * @return uint64_t Id
+ */
+[[nodiscard]] uint64_t identify(uint64_t module, kind type, size_t entry);
+
+/**
+ * @brief Seconds entries took in past runs, by entry id. Kept as a
+ * moving average, in a file across runs. Entries not timed in a while
+ * age out of it. Safe to share between workers, and between processes
+ * saving to the same file
+ * 
+ */
+struct history {
+    //
+    // CONSTRUCTORS
+    //
+
+    history() = default;
+
+    /**
+     * @brief Construct a new history object, reading file back
+     * 
+     * @param path File, none for one only kept in memory
+     */
+    [[nodiscard]] history(const std::filesystem::path& path);
+
+  private:
+    //
+    // LOCAL
+    //
+
+    struct timing {
+        double seconds = 0;
+
+        // seconds since epoch it was last timed at, and whether that was this run
+        int64_t timed = 0;
+        bool recorded = false;
+    };
+
+    /**
+     * @brief Read timings file, less what's aged out of it
+     * 
+     * @param path File
+     * @param now Seconds since epoch
+     * @return std::unordered_map<uint64_t, timing> Timings, by entry id
+     */
+    [[nodiscard]] static std::unordered_map<uint64_t, timing> read(const std::filesystem::path& path, int64_t now);
+
+    //
+    // DATA
+    //
+
+    std::filesystem::path _path = {};
+
+    // seconds since epoch this run started at
+    int64_t _now = 0;
+
+    mutable std::mutex _mutex                     = {};
+    std::unordered_map<uint64_t, timing> _timings = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    /**
+     * @brief Find what entry took in past runs
+     * 
+     * @param id Entry id
+     * @return std::optional<double> Seconds, none if it's never been timed
+     */
+    [[nodiscard]] std::optional<double> find(uint64_t id) const;
+
+    /**
+     * @brief Record what entry took this run
+     * 
+     * @param id Entry id
+     * @param seconds Seconds
+     */
+    void record(uint64_t id, double seconds);
+
+    /**
+     * @brief Write file, when there's one. What's on file is read over
+     * first, so timings other processes saved since are kept
+     * 
+     */
+    void save() const;
+};
+
+/**
+ * @brief Execution plan of a module's entries. Each entry gets a cost,
+ * from past runs when it's been timed before and from a model of the
+ * module's section sizes otherwise. Signatures sharing a section are
+ * batched into one pass, and string searches and convars sharing one get
+ * a pass indexing the references to all of their strings, when that's
+ * cheaper than a scan per string. Passes run first, then entries, both
+ * costliest first
+ * 
+ */
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object, planning entries
+     * 
+     * @param module Module entries are of
+     * @param entries Entries
+     * @param past Timings of past runs
+     */
+    [[nodiscard]] context(const modules::context& module, std::vector<entry> entries, const history& past);
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Estimate what entry costs, from how much of module it scans
+     * 
+     * @param module Module
+     * @param planned Entry
+     * @param walked Whether what it walks was already paid for by an earlier entry
+     * @return double Seconds
+     */
+    [[nodiscard]] double estimate(const modules::context& module, const entry& planned, bool walked) const;
+
+    //
+    // DATA
+    //
+
+    // costliest first
+    std::vector<entry> _entries = {};
+    std::vector<pass> _passes   = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    [[nodiscard]] inline const auto& get_entries() const {
+        return _entries;
+    }
+
+    [[nodiscard]] inline const auto& get_passes() const {
+        return _passes;
+    }
+
+    /**
+     * @brief Run passes on module, so the entries they batch are lookups after
+     * 
+     * @param module Module planned for
+     * @param scratch Where temporaries are allocated from
+     * @return std::vector<double> Seconds of pass time each entry's share, by position in get_entries
+     */
+    [[nodiscard]] std::vector<double> run(const modules::context& module, std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) const;
+
+    /**
+     * @brief Write plan out for people to read
+     * 
+     * @param out Stream
+     * @param name Module name
+     */
+    void explain(std::ostream& out, std::string_view name) const;
+};
+}  // namespace plan
+// ===========================================
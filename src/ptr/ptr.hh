@@ -27,11 +27,14 @@ struct ptr {
      * 
      * @tparam T Passed argument type
      * @param address 
+     * @param rebase Added to every dereferenced value, maps image addresses
+     * that weren't relocated by the loader back into the local mapping
      */
     template<typename T>
     requires std::is_integral_v<T> || std::is_pointer_v<T>
-    [[nodiscard]] inline ptr(T address)
-        : _address((uintptr_t)address) {}
+    [[nodiscard]] inline ptr(T address, uintptr_t rebase = 0)
+        : _address((uintptr_t)address)
+        , _rebase(rebase) {}
 
   private:
     //
@@ -39,6 +42,7 @@ struct ptr {
     //
 
     uintptr_t _address;
+    uintptr_t _rebase = 0;
 
   public:
     //
@@ -73,6 +77,13 @@ struct ptr {
         return _this;
     }
 
+    /**
+     * @brief Follow the pointer n times
+     * 
+     * @tparam W Pointer width of the image we're reading from
+     * @param n Times to dereference
+     */
+    template<typename W = uintptr_t>
     inline auto dereference(size_t n) {
         auto out = _address;
         for (auto i = 0; i < n; ++i) {
@@ -81,15 +92,16 @@ struct ptr {
                 break;
             }
 
-            out = *(uintptr_t*)out;
+            out = (uintptr_t)(*(W*)out) + _rebase;
         }
 
         _address = out;
     }
 
+    template<typename W = uintptr_t>
     [[nodiscard]] inline auto dereferenced(size_t n) const {
         auto _this = *this;
-        _this.dereference(n);
+        _this.template dereference<W>(n);
         return _this;
     }
 
@@ -98,6 +110,10 @@ struct ptr {
         return (T)_address;
     }
 
+    constexpr auto get_rebase() const {
+        return _rebase;
+    }
+
     /**
      * @brief Get the byte at current address
      * 
@@ -0,0 +1,169 @@
+/**
+ * @file rtti.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief MSVC RTTI index
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "rtti.hh"
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <string>
+// ===========================================
+
+// ===========================================
+namespace rtti {
+namespace detail {
+template<typename T>
+inline T load(const uint8_t* at) {
+    T out;
+    std::memcpy(&out, at, sizeof(T));
+    return out;
+}
+
+// x86 locators point with absolute addresses, x64 ones with relative
+// addresses and a signature of 1, ending in one to themselves
+struct locator {
+    uint32_t signature;
+    uint32_t offset;
+    uint32_t constructor_offset;
+    uint32_t descriptor;
+    uint32_t hierarchy;
+    uint32_t self;
+};
+}  // namespace detail
+}  // namespace rtti
+
+using namespace rtti;
+context::context(const modules::context& module)
+    : _module(&module) {
+    module.visit_width([&]<typename W>(W) {
+        build<W>();
+    });
+}
+
+template<typename W>
+void context::build() {
+    const auto& module = *_module;
+    const auto bytes   = module.get_bytes();
+    constexpr auto x64 = std::is_same_v<W, uint64_t>;
+
+    const auto bounds = [&](std::string_view name) -> std::pair<uintptr_t, uintptr_t> {
+        if (!module.get_sections().contains(name)) {
+            return {0, 0};
+        }
+
+        module.page_in(name);
+
+        const auto& section = module.get_section(name);
+        return {section.start, section.size};
+    };
+
+    // image addresses a pointer could hold, relative
+    const auto relative = [&](uint64_t address) -> std::optional<uint32_t> {
+        if (address < module.get_image_base() || address >= (module.get_image_base() + module.get_size())) {
+            return std::nullopt;
+        }
+
+        return (uint32_t)(address - module.get_image_base());
+    };
+
+    // descriptors are { type_info vtable, spare, name }, named ".?AV" for
+    // classes and ".?AU" for structs
+    std::unordered_map<uint32_t, std::string_view> descriptors = {};
+    {
+        const auto [start, size] = bounds(".data");
+        const auto data          = std::string_view {(const char*)&bytes[start], size};
+
+        for (auto at = data.find(".?A"); at != std::string_view::npos; at = data.find(".?A", at + 1)) {
+            if ((at + 4) > data.size() || (data[at + 3] != 'V' && data[at + 3] != 'U') || (at < (2 * sizeof(W)))) {
+                continue;
+            }
+
+            const auto end = data.find('\0', at);
+            if (end == std::string_view::npos) {
+                break;
+            }
+
+            descriptors.emplace((uint32_t)(start + at - (2 * sizeof(W))), data.substr(at, end - at));
+        }
+    }
+
+    if (descriptors.empty()) {
+        return;
+    }
+
+    const auto [start, size] = bounds(".rdata");
+    const auto extent        = x64 ? sizeof(detail::locator) : offsetof(detail::locator, self);
+
+    // locators are 4 aligned, and all of them come before this pass is over
+    std::unordered_map<uint32_t, type> locators = {};
+    for (auto i = start; (i + extent) <= (start + size); i += sizeof(uint32_t)) {
+        // x86 locators end before the self field
+        detail::locator locator = {};
+        std::memcpy(&locator, &bytes[i], extent);
+
+        if (locator.signature != (x64 ? 1u : 0u)) {
+            continue;
+        }
+
+        const auto descriptor = x64 ? std::optional<uint32_t> {locator.descriptor} : relative(locator.descriptor);
+        if (!descriptor.has_value() || !descriptors.contains(descriptor.value())) {
+            continue;
+        }
+
+        if (x64 && locator.self != (uint32_t)i) {
+            continue;
+        }
+
+        locators.emplace((uint32_t)i, type {descriptor.value(), (uint32_t)i, 0, locator.offset});
+    }
+
+    // vtables are pointer aligned, right after a pointer to their locator
+    for (auto i = start; (i + (2 * sizeof(W))) <= (start + size); i += sizeof(W)) {
+        const auto pointer = relative(detail::load<W>(&bytes[i]));
+        if (!pointer.has_value()) {
+            continue;
+        }
+
+        if (auto found = locators.find(pointer.value()); found != locators.end()) {
+            auto out   = found->second;
+            out.vtable = (uint32_t)(i + sizeof(W));
+
+            _types[descriptors[out.descriptor]].push_back(out);
+        }
+    }
+}
+
+std::optional<ptr> context::find_vtable(std::string_view name, uint32_t offset) const {
+    auto found = _types.find(name);
+
+    // plain names could be either a class or a struct
+    if (found == _types.end() && !name.starts_with(".?A")) {
+        for (const auto& kind : {".?AV", ".?AU"}) {
+            found = _types.find(std::string {kind} + std::string {name} + "@@");
+            if (found != _types.end()) {
+                break;
+            }
+        }
+    }
+
+    if (found == _types.end()) {
+        return std::nullopt;
+    }
+
+    for (const auto& type : found->second) {
+        if (type.offset == offset) {
+            return ptr(_module->get_at(type.vtable), _module->get_rebase());
+        }
+    }
+
+    return std::nullopt;
+}
+// ===========================================
@@ -0,0 +1,99 @@
+#pragma once
+
+// ===========================================
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include "../ctx/ctx.hh"
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains MSVC RTTI structs
+ * restrained to context
+ * 
+ */
+namespace rtti {
+namespace have {
+    struct type {
+        //
+        // DATA
+        //
+
+        // relative addresses
+        uint32_t descriptor = 0;
+        uint32_t locator    = 0;
+        uint32_t vtable     = 0;
+
+        // offset of the subobject the vtable belongs to
+        uint32_t offset = 0;
+    };
+}  // namespace have
+
+/**
+ * @brief Index of every class a module has RTTI for, built in one linear
+ * pass over each section involved:
+ * - TypeDescriptors, by their ".?AV"/".?AU" decorated names, in .data
+ * - CompleteObjectLocators referencing them, in .rdata
+ * - vtables, right after a pointer to a locator, in .rdata
+ * 
+ */
+using namespace have;
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object, indexing module
+     * 
+     * @param module Module, has to outlive the index, names point into it
+     */
+    [[nodiscard]] context(const modules::context& module);
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Index image laid out for pointer width
+     * 
+     * @tparam W Pointer width
+     */
+    template<typename W>
+    void build();
+
+    //
+    // DATA
+    //
+
+    const modules::context* _module = nullptr;
+
+    // decorated name to every vtable of the class, by address
+    std::unordered_map<std::string_view, std::vector<type>> _types = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    [[nodiscard]] inline const auto& get_types() const {
+        return _types;
+    }
+
+    /**
+     * @brief Find vtable of class
+     * 
+     * @param name Decorated (".?AVName@@") or plain class name
+     * @param offset Offset of the subobject whose vtable is wanted, 0 for the complete object's
+     * @return std::optional<ptr> Contained pointer
+     */
+    [[nodiscard]] std::optional<ptr> find_vtable(std::string_view name, uint32_t offset) const;
+};
+}  // namespace rtti
+// ===========================================
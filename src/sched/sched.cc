@@ -0,0 +1,64 @@
+/**
+ * @file sched.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Memory budgeted module scheduling
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "sched.hh"
+#include <algorithm>
+// ===========================================
+
+// ===========================================
+using namespace sched;
+context::context(size_t budget)
+    : _budget(budget) {}
+
+void context::push(size_t index, size_t cost) {
+    std::scoped_lock lock(_mutex);
+
+    auto at = std::ranges::upper_bound(_jobs, cost, std::greater {}, &job::cost);
+    _jobs.insert(at, job {index, cost});
+}
+
+std::optional<job> context::pop() {
+    std::unique_lock lock(_mutex);
+
+    while (!_jobs.empty()) {
+        auto fits = std::ranges::find_if(_jobs, [&](const job& candidate) {
+            return !_budget || ((_in_use + candidate.cost) <= _budget);
+        });
+
+        // with nothing in flight the costliest always goes, even if it's
+        // over budget on its own, otherwise it would wait on nothing
+        if (!_in_use) {
+            fits = _jobs.begin();
+        }
+
+        if (fits != _jobs.end()) {
+            auto out = *fits;
+            _jobs.erase(fits);
+            _in_use += out.cost;
+            return out;
+        }
+
+        _released.wait(lock);
+    }
+
+    return std::nullopt;
+}
+
+void context::release(const job& done) {
+    {
+        std::scoped_lock lock(_mutex);
+        _in_use -= done.cost;
+    }
+
+    _released.notify_all();
+}
+// ===========================================
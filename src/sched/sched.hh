@@ -0,0 +1,97 @@
+#pragma once
+
+// ===========================================
+#include <vector>
+#include <mutex>
+#include <optional>
+#include <condition_variable>
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains module work scheduling structs
+ * restrained to context
+ * 
+ */
+namespace sched {
+namespace have {
+    struct job {
+        //
+        // DATA
+        //
+
+        size_t index = 0;
+        size_t cost  = 0;
+    };
+}  // namespace have
+
+/**
+ * @brief Hands out jobs so the sum of the costs of those
+ * in flight stays under a memory budget. Costliest jobs
+ * that still fit go first, so big modules don't end up
+ * waiting for a tail of small ones
+ * 
+ */
+using namespace have;
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object
+     * 
+     * @param budget Total cost allowed in flight, 0 being unlimited
+     */
+    [[nodiscard]] context(size_t budget);
+
+  private:
+    //
+    // DATA
+    //
+
+    size_t _budget = 0;
+    size_t _in_use = 0;
+
+    // kept sorted by cost, descending
+    std::vector<job> _jobs = {};
+
+    std::mutex _mutex                 = {};
+    std::condition_variable _released = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    inline auto get_budget() const {
+        return _budget;
+    }
+
+    /**
+     * @brief Queue job
+     * 
+     * @param index User-defined job identifier
+     * @param cost Cost accounted against the budget while job runs
+     */
+    void push(size_t index, size_t cost);
+
+    /**
+     * @brief Take costliest job that fits in the budget, blocking until one does.
+     * A job costlier than the whole budget runs alone
+     * 
+     * @return std::optional<job> Job, none when the queue is drained
+     */
+    [[nodiscard]] std::optional<job> pop();
+
+    /**
+     * @brief Give back job cost to the budget
+     * 
+     * @param done Job popped earlier
+     */
+    void release(const job& done);
+};
+}  // namespace sched
+// ===========================================
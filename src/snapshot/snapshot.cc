@@ -0,0 +1,267 @@
+/**
+ * @file snapshot.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Process snapshots, minidumps and raw dumps
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include "snapshot.hh"
+#include <DbgHelp.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cctype>
+#include <optional>
+// ===========================================
+
+// ===========================================
+namespace snapshot {
+namespace detail {
+// names read out of dumps are file names, anything longer isn't one
+constexpr size_t max_name = 0x100;
+
+/**
+ * File name of path, lower case
+ */
+inline auto file_name(std::string_view path) {
+    std::string out {path.substr(path.find_last_of("\\/") + 1)};
+    std::ranges::transform(out, out.begin(), [](char c) {
+        return (char)std::tolower((unsigned char)c);
+    });
+
+    return out;
+}
+}  // namespace detail
+}  // namespace snapshot
+
+using namespace snapshot;
+context::context(const std::string& path) {
+    _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (_file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed loading " + path);
+    }
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(_file, &size) || !size.QuadPart) {
+        release();
+        throw std::runtime_error("Failed reading " + path);
+    }
+
+    _size    = (uint64_t)size.QuadPart;
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    _view    = _mapping ? (const uint8_t*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!_view) {
+        release();
+        throw std::runtime_error("Failed mapping " + path);
+    }
+
+    // destructor doesn't run for a throwing constructor
+    try {
+        if (*at<ULONG32>(0) == MINIDUMP_SIGNATURE) {
+            parse_minidump();
+        } else {
+            parse_raw(path);
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+context::~context() {
+    release();
+}
+
+void context::release() {
+    if (_view) {
+        UnmapViewOfFile(_view);
+        _view = nullptr;
+    }
+
+    if (_mapping) {
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+    }
+
+    if (_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(_file);
+        _file = INVALID_HANDLE_VALUE;
+    }
+}
+
+template<typename T>
+const T* context::at(uint64_t offset, uint64_t count) const {
+    if ((offset > _size) || (count > ((_size - offset) / sizeof(T)))) {
+        throw std::runtime_error("Dump is truncated.");
+    }
+
+    return (const T*)(_view + offset);
+}
+
+void context::parse_minidump() {
+    const auto* header  = at<MINIDUMP_HEADER>(0);
+    const auto* streams = at<MINIDUMP_DIRECTORY>(header->StreamDirectoryRva, header->NumberOfStreams);
+
+    std::optional<RVA> modules = std::nullopt;
+    for (ULONG32 i = 0; i < header->NumberOfStreams; ++i) {
+        const auto& stream = streams[i];
+
+        switch (stream.StreamType) {
+            case ModuleListStream: {
+                modules = stream.Location.Rva;
+            } break;
+            case MemoryListStream: {
+                // small dumps, ranges sit wherever in the file
+                const auto count   = *at<ULONG32>(stream.Location.Rva);
+                const auto* ranges = at<MINIDUMP_MEMORY_DESCRIPTOR>(stream.Location.Rva + offsetof(MINIDUMP_MEMORY_LIST, MemoryRanges), count);
+                for (ULONG32 j = 0; j < count; ++j) {
+                    _ranges.push_back({ranges[j].StartOfMemoryRange, ranges[j].Memory.DataSize, ranges[j].Memory.Rva});
+                }
+            } break;
+            case Memory64ListStream: {
+                // full memory dumps, ranges follow each other from BaseRva on
+                const auto count   = *at<ULONG64>(stream.Location.Rva);
+                const auto* ranges = at<MINIDUMP_MEMORY_DESCRIPTOR64>(stream.Location.Rva + offsetof(MINIDUMP_MEMORY64_LIST, MemoryRanges), count);
+
+                auto offset = *at<RVA64>(stream.Location.Rva + offsetof(MINIDUMP_MEMORY64_LIST, BaseRva));
+                for (ULONG64 j = 0; j < count; ++j) {
+                    _ranges.push_back({ranges[j].StartOfMemoryRange, ranges[j].DataSize, offset});
+                    offset += ranges[j].DataSize;
+                }
+            } break;
+            default: {
+            } break;
+        }
+    }
+
+    // a range running past the end of the file is cut to what's there
+    for (auto& value : _ranges) {
+        value.size = std::min(value.size, _size - std::min(value.offset, _size));
+    }
+
+    std::erase_if(_ranges, [](const range& value) {
+        return !value.size;
+    });
+
+    std::ranges::sort(_ranges, {}, &range::start);
+
+    if (!modules.has_value()) {
+        throw std::runtime_error("Dump has no module list.");
+    }
+
+    const auto count = *at<ULONG32>(modules.value());
+    const auto* list = at<MINIDUMP_MODULE>(modules.value() + offsetof(MINIDUMP_MODULE_LIST, Modules), count);
+    for (ULONG32 i = 0; i < count; ++i) {
+        const auto& module = list[i];
+
+        // names are counted UTF-16, full paths
+        const auto length  = (int)std::min<size_t>(*at<ULONG32>(module.ModuleNameRva) / sizeof(WCHAR), detail::max_name);
+        const auto* buffer = at<WCHAR>(module.ModuleNameRva + offsetof(MINIDUMP_STRING, Buffer), length);
+
+        std::string path(detail::max_name * 4, '\0');
+        path.resize(std::max(WideCharToMultiByte(CP_UTF8, 0, buffer, length, path.data(), (int)path.size(), nullptr, nullptr), 0));
+
+        _images.push_back({detail::file_name(path), module.BaseOfImage, module.SizeOfImage});
+    }
+}
+
+void context::parse_raw(const std::string& path) {
+    const auto* dos_header = at<IMAGE_DOS_HEADER>(0);
+    if (dos_header->e_magic != IMAGE_DOS_SIGNATURE) {
+        throw std::runtime_error(path + " is neither a minidump nor a PE image.");
+    }
+
+    // SizeOfImage sits at the same offset in PE32 and PE32+, the rest doesn't
+    const auto* nt_headers = at<IMAGE_NT_HEADERS32>(dos_header->e_lfanew);
+
+    uint64_t base    = 0;
+    uint32_t exports = 0;
+    if (nt_headers->OptionalHeader.Magic == IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
+        const auto* headers = at<IMAGE_NT_HEADERS64>(dos_header->e_lfanew);
+        base                = headers->OptionalHeader.ImageBase;
+        exports             = headers->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].VirtualAddress;
+    } else {
+        base    = nt_headers->OptionalHeader.ImageBase;
+        exports = nt_headers->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].VirtualAddress;
+    }
+
+    // laid out as in memory, so addresses relative to the image are file offsets
+    auto name = detail::file_name(path);
+    if (exports && ((uint64_t)exports + sizeof(IMAGE_EXPORT_DIRECTORY)) <= _size) {
+        const auto offset = at<IMAGE_EXPORT_DIRECTORY>(exports)->Name;
+        if (offset < _size) {
+            const auto* first = (const char*)(_view + offset);
+            const auto length = strnlen(first, std::min<uint64_t>(detail::max_name, _size - offset));
+            if (length) {
+                name = detail::file_name({first, length});
+            }
+        }
+    }
+
+    const auto size = std::min<uint64_t>(nt_headers->OptionalHeader.SizeOfImage, _size);
+
+    _ranges.push_back({base, size, 0});
+    _images.push_back({name, base, nt_headers->OptionalHeader.SizeOfImage});
+}
+
+const image* context::find_image(std::string_view name) const {
+    const auto wanted = detail::file_name(name);
+
+    const auto found = std::ranges::find(_images, wanted, &image::name);
+    return (found != _images.end()) ? &*found : nullptr;
+}
+
+const uint8_t* context::view(uint64_t address, size_t size) const {
+    // last range starting at or before address
+    auto it = std::ranges::upper_bound(_ranges, address, {}, &range::start);
+    if (it == _ranges.begin()) {
+        return nullptr;
+    }
+
+    const auto& first = *--it;
+    if (address >= (first.start + first.size)) {
+        return nullptr;
+    }
+
+    // ranges following each other both in memory and in the file are one piece
+    auto end = first.start + first.size;
+    for (auto next = it + 1; (end < (address + size)) && (next != _ranges.end()); ++next) {
+        const auto& last = *(next - 1);
+        if ((next->start != end) || (next->offset != (last.offset + last.size))) {
+            break;
+        }
+
+        end += next->size;
+    }
+
+    if (end < (address + size)) {
+        return nullptr;
+    }
+
+    return _view + first.offset + (address - first.start);
+}
+
+bool context::copy(uint64_t address, size_t size, uint8_t* out) const {
+    std::memset(out, 0, size);
+
+    uint64_t copied = 0;
+    for (const auto& value : _ranges) {
+        const auto begin = std::max(address, value.start);
+        const auto end   = std::min(address + size, value.start + value.size);
+        if (begin >= end) {
+            continue;
+        }
+
+        std::memcpy(&out[begin - address], _view + value.offset + (begin - value.start), end - begin);
+        copied += end - begin;
+    }
+
+    // ranges of a process don't overlap
+    return copied == size;
+}
+// ===========================================
@@ -0,0 +1,174 @@
+#pragma once
+
+// ===========================================
+#include <Windows.h>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <string_view>
+// ===========================================
+
+// ===========================================
+/**
+ * @brief Contains process snapshot structs
+ * restrained to context
+ * 
+ */
+namespace snapshot {
+namespace have {
+    struct range {
+        //
+        // DATA
+        //
+
+        // address in the process, and where its bytes are in the file
+        uint64_t start  = 0;
+        uint64_t size   = 0;
+        uint64_t offset = 0;
+    };
+
+    struct image {
+        //
+        // DATA
+        //
+
+        // file name, lower case
+        std::string name = {};
+
+        // where the process loaded it
+        uint64_t base = 0;
+        size_t size   = 0;
+    };
+}  // namespace have
+
+/**
+ * @brief Memory of a process, as captured in a minidump (.dmp) or in a raw
+ * dump of one image as it was laid out in memory, mapped read-only. Images
+ * are found by the module list of a minidump, with their bytes in its memory
+ * ranges. A raw dump is taken to sit at the base its headers name, and is named
+ * after what it exports as, or its file when it doesn't export anything
+ * 
+ * A minidump only has images' memory if it was written with it, like with
+ * MiniDumpWithFullMemory
+ * 
+ */
+using namespace have;
+struct context {
+    //
+    // CONSTRUCTORS
+    //
+
+    context() = default;
+
+    /**
+     * @brief Construct a new context object, mapping a dump
+     * 
+     * @param path Path to minidump or raw dump
+     */
+    [[nodiscard]] context(const std::string& path);
+
+    context(const context&) = delete;
+    context& operator=(const context&) = delete;
+
+    /**
+     * @brief Destroy the context object
+     * 
+     * Unmaps the dump
+     * 
+     */
+    ~context();
+
+  private:
+    //
+    // LOCAL
+    //
+
+    /**
+     * @brief Unmap dump and close it
+     * 
+     */
+    void release();
+
+    /**
+     * @brief Index minidump's modules and memory ranges
+     * 
+     */
+    void parse_minidump();
+
+    /**
+     * @brief Index raw dump as the one image in it
+     * 
+     * @param path Path it was mapped from
+     */
+    void parse_raw(const std::string& path);
+
+    /**
+     * @brief Get structures in the file, checking they're all in it
+     * 
+     * @tparam T Structure
+     * @param offset Offset in file
+     * @param count Structures
+     * @return const T* First structure
+     */
+    template<typename T>
+    [[nodiscard]] const T* at(uint64_t offset, uint64_t count = 1) const;
+
+    //
+    // DATA
+    //
+
+    HANDLE _file    = INVALID_HANDLE_VALUE;
+    HANDLE _mapping = nullptr;
+
+    const uint8_t* _view = nullptr;
+    uint64_t _size       = 0;
+
+    // sorted by address
+    std::vector<range> _ranges = {};
+    std::vector<image> _images = {};
+
+  public:
+    //
+    // UTILITY
+    //
+
+    [[nodiscard]] inline const auto& get_images() const {
+        return _images;
+    }
+
+    [[nodiscard]] inline const auto& get_ranges() const {
+        return _ranges;
+    }
+
+    /**
+     * @brief Find image by file name, ignoring case
+     * 
+     * @param name File name, or path ending in one
+     * @return const image* Image, nullptr if there's no such one
+     */
+    [[nodiscard]] const image* find_image(std::string_view name) const;
+
+    /**
+     * @brief View memory of the process straight out of the mapping
+     * 
+     * @param address Address in the process
+     * @param size Bytes
+     * @return const uint8_t* Bytes, nullptr unless every one of
+     * them was captured, and laid out in one piece in the file
+     */
+    [[nodiscard]] const uint8_t* view(uint64_t address, size_t size) const;
+
+    /**
+     * @brief Copy memory of the process out of the mapping, what
+     * wasn't captured being zero filled
+     * 
+     * @param address Address in the process
+     * @param size Bytes
+     * @param out Where to copy to
+     * @return true Every byte was captured
+     * @return false Some weren't
+     */
+    bool copy(uint64_t address, size_t size, uint8_t* out) const;
+};
+}  // namespace snapshot
+// ===========================================
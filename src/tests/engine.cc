@@ -0,0 +1,428 @@
+/**
+ * @file engine.cc
+ * @author Cristei Gabriel-Marian (cristei.g772@gmail.com)
+ * @brief Golden-output tests of the scanning engine, over images built in memory
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+// ===========================================
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <array>
+#include <tuple>
+#include <set>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <Windows.h>
+// ===========================================
+#include "../ctx/ctx.hh"
+#include "../pattern/pattern.hh"
+#include "../vendor/json/json.hh"
+// ===========================================
+
+// ===========================================
+namespace tests {
+namespace detail {
+// one layout for both widths. sections span a few windows, so
+// streamed scans have matches and references straddling them
+constexpr uint32_t text      = 0x1000;
+constexpr uint32_t rdata     = 0x6000;
+constexpr uint32_t data      = 0x9000;
+constexpr uint32_t image     = 0xA000;
+constexpr uint32_t headers   = 0x400;
+constexpr uint64_t preferred = 0x10000000;
+constexpr size_t window      = 0x1000;
+
+// .data has less on disk than it spans, the rest is zero filled
+constexpr uint32_t data_raw = 0x800;
+
+// export directory, in .rdata
+constexpr uint32_t exports = rdata + 0x2000;
+
+// a run longer than one Shift-Or word, every 9th byte left out of its pattern
+constexpr uint32_t long_run  = text + 0x2400;
+constexpr uint32_t long_size = 80;
+
+constexpr uint8_t long_byte(uint32_t i) {
+    return (uint8_t)((i * 37) + 11);
+}
+
+/**
+ * Image as the loader would map it, and as it's laid out on disk
+ */
+struct builder {
+    //
+    // CONSTRUCTORS
+    //
+
+    builder(bool x64)
+        : x64(x64)
+        , bytes(image) {
+        auto dos      = (PIMAGE_DOS_HEADER)bytes.data();
+        dos->e_magic  = IMAGE_DOS_SIGNATURE;
+        dos->e_lfanew = 0x80;
+
+        // file header and section list sit the same in both layouts
+        auto nt                             = (PIMAGE_NT_HEADERS32)&bytes[dos->e_lfanew];
+        nt->Signature                       = IMAGE_NT_SIGNATURE;
+        nt->FileHeader.Machine              = x64 ? IMAGE_FILE_MACHINE_AMD64 : IMAGE_FILE_MACHINE_I386;
+        nt->FileHeader.NumberOfSections     = 3;
+        nt->FileHeader.SizeOfOptionalHeader = x64 ? sizeof(IMAGE_OPTIONAL_HEADER64) : sizeof(IMAGE_OPTIONAL_HEADER32);
+
+        if (x64) {
+            auto& optional         = ((PIMAGE_NT_HEADERS64)nt)->OptionalHeader;
+            optional.Magic         = IMAGE_NT_OPTIONAL_HDR64_MAGIC;
+            optional.ImageBase     = preferred;
+            optional.SizeOfImage   = image;
+            optional.SizeOfHeaders = headers;
+        } else {
+            auto& optional         = nt->OptionalHeader;
+            optional.Magic         = IMAGE_NT_OPTIONAL_HDR32_MAGIC;
+            optional.ImageBase     = (DWORD)preferred;
+            optional.SizeOfImage   = image;
+            optional.SizeOfHeaders = headers;
+        }
+
+        const std::array<std::tuple<const char*, uint32_t, uint32_t, uint32_t>, 3> sections = {{
+            {".text", text, rdata - text, rdata - text},
+            {".rdata", rdata, data - rdata, data - rdata},
+            {".data", data, image - data, data_raw},
+        }};
+
+        auto section = IMAGE_FIRST_SECTION(nt);
+        auto raw     = headers;
+        for (const auto& [name, start, size, on_disk] : sections) {
+            std::memcpy(section->Name, name, std::strlen(name));
+            section->VirtualAddress   = start;
+            section->Misc.VirtualSize = size;
+            section->SizeOfRawData    = on_disk;
+            section->PointerToRawData = raw;
+
+            raw += on_disk;
+            ++section;
+        }
+    }
+
+    //
+    // DATA
+    //
+
+    bool x64                   = false;
+    std::vector<uint8_t> bytes = {};
+
+    //
+    // UTILITY
+    //
+
+    inline void put(uint32_t rva, std::initializer_list<uint8_t> values) {
+        std::memcpy(&bytes[rva], values.begin(), values.size());
+    }
+
+    inline void put32(uint32_t rva, uint32_t value) {
+        std::memcpy(&bytes[rva], &value, sizeof(value));
+    }
+
+    inline void put_string(uint32_t rva, std::string_view string) {
+        std::memcpy(&bytes[rva], string.data(), string.size());
+        bytes[rva + string.size()] = 0;
+    }
+
+    /**
+     * Reference target from at, absolute on x86 and rip-relative on x64
+     */
+    inline void reference(uint32_t at, uint32_t target) {
+        put32(at, x64 ? (target - (at + sizeof(uint32_t))) : (uint32_t)(preferred + target));
+    }
+
+    /**
+     * Export every name, in order, at its address. A forwarder's address
+     * is its "module.name" string, written inside the directory
+     */
+    void export_all(const std::vector<std::tuple<std::string_view, uint32_t, std::string_view>>& procedures) {
+        auto directory = (PIMAGE_EXPORT_DIRECTORY)&bytes[exports];
+        auto at        = (uint32_t)(exports + sizeof(IMAGE_EXPORT_DIRECTORY));
+
+        directory->NumberOfFunctions     = (DWORD)procedures.size();
+        directory->NumberOfNames         = (DWORD)procedures.size();
+        directory->AddressOfFunctions    = at;
+        directory->AddressOfNames        = at + (uint32_t)(procedures.size() * sizeof(DWORD));
+        directory->AddressOfNameOrdinals = at + (uint32_t)(procedures.size() * sizeof(DWORD) * 2);
+
+        at = directory->AddressOfNameOrdinals + (uint32_t)(procedures.size() * sizeof(WORD));
+        for (size_t i = 0; i < procedures.size(); ++i) {
+            const auto& [name, address, forward] = procedures[i];
+            const auto ordinal                   = (WORD)i;
+
+            put32(directory->AddressOfNames + (uint32_t)(i * sizeof(DWORD)), at);
+            std::memcpy(&bytes[directory->AddressOfNameOrdinals + (i * sizeof(WORD))], &ordinal, sizeof(ordinal));
+
+            put_string(at, name);
+            at += (uint32_t)name.size() + 1;
+
+            if (forward.empty()) {
+                put32(directory->AddressOfFunctions + (uint32_t)(i * sizeof(DWORD)), address);
+                continue;
+            }
+
+            put32(directory->AddressOfFunctions + (uint32_t)(i * sizeof(DWORD)), at);
+            put_string(at, forward);
+            at += (uint32_t)forward.size() + 1;
+        }
+
+        auto nt        = &bytes[((PIMAGE_DOS_HEADER)bytes.data())->e_lfanew];
+        auto& exported = x64 ? ((PIMAGE_NT_HEADERS64)nt)->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT] : ((PIMAGE_NT_HEADERS32)nt)->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+        exported       = {exports, at - exports};
+    }
+
+    /**
+     * Write as laid out on disk
+     */
+    void write(const std::filesystem::path& path) const {
+        std::vector<uint8_t> file(bytes.begin(), bytes.begin() + headers);
+        file.insert(file.end(), bytes.begin() + text, bytes.begin() + data + data_raw);
+
+        std::ofstream(path, std::ios::binary).write((const char*)file.data(), file.size());
+    }
+};
+
+/**
+ * Plant everything the entries look for
+ */
+inline builder plant(bool x64) {
+    builder out(x64);
+
+    // the same prologue thrice, the second across the first window's end
+    for (const auto at : {text + 0x100, text + 0xFFD, text + 0x3000}) {
+        out.put(at, {0x55, 0x8B, 0xEC, 0x83, 0xE4, 0xF8});
+    }
+
+    for (uint32_t i = 0; i < long_size; ++i) {
+        out.bytes[long_run + i] = long_byte(i);
+    }
+
+    // strings, one referenced thrice, the second reference straddling windows
+    out.put_string(rdata + 0x100, "VEngineClient014");
+    out.put_string(rdata + 0x200, "abc");
+    out.put_string(rdata + 0x300, "r_aspectratio");
+    out.put_string(rdata + 0x320, "cl_cmdrate");
+    out.put_string(rdata + 0x340, "sv_cheats");
+
+    out.reference(text + 0x500, rdata + 0x100);
+    out.reference(text + 0x1FFE, rdata + 0x100);
+    out.reference(text + 0x4000, rdata + 0x100);
+    out.reference(data + 0x40, rdata + 0x100);
+
+    // only the tail of a longer string, and one too short for the table
+    out.reference(text + 0x600, rdata + 0x107);
+    out.reference(text + 0x700, rdata + 0x200);
+
+    // ConVar constructors, x86 only. mov [disp32], imm32; mov ecx, convar;
+    // push name; call, and push imm32; push name; call; mov [disp32], imm32
+    if (!x64) {
+        out.put(text + 0x800, {0xC7, 0x05, 0x11, 0x11, 0x11, 0x11, 0x22, 0x22, 0x22, 0x22, 0xB9, 0x33, 0x33, 0x33, 0x33, 0x68, 0, 0, 0, 0, 0xE8, 0, 0, 0, 0});
+        out.reference(text + 0x810, rdata + 0x300);
+
+        out.put(text + 0x900, {0x68, 0, 0, 0, 0, 0x68, 0, 0, 0, 0, 0xE8, 0, 0, 0, 0, 0xC7, 0x05, 0x44, 0x44, 0x44, 0x44, 0, 0, 0, 0});
+        out.reference(text + 0x906, rdata + 0x320);
+
+        // referenced, but not by a constructor
+        out.put(text + 0xA00, {0x68, 0, 0, 0, 0, 0x90, 0x90, 0x90, 0x90});
+        out.reference(text + 0xA01, rdata + 0x340);
+    }
+
+    out.export_all({{"CreateInterface", text + 0x1000, {}}, {"Forwarded", 0, "other.Function"}, {"GetVersion", text + 0x1100, {}}});
+
+    return out;
+}
+
+/**
+ * Resolve every entry, as their relative addresses. Engines that
+ * disagree with the picked one are counted in failures
+ */
+inline nlohmann::json resolve(const modules::context& dll, bool x64, size_t& failures, std::string_view mode) {
+    nlohmann::json out = nlohmann::json::object();
+
+    // engines that ran against at least one pattern
+    std::set<pattern::context::engine> ran = {};
+
+    const auto rva = [&](const std::optional<ptr>& found) {
+        return found.has_value() ? nlohmann::json(found.value().get() - (uintptr_t)dll.get_bytes()) : nlohmann::json(nullptr);
+    };
+
+    const std::vector<std::tuple<std::string, std::string, size_t>> signatures = {
+        {"prologue", "55 8B EC 83 E4 F8", 0},
+        {"prologue#1", "55 8B EC 83 E4 F8", 1},
+        {"prologue#2", "55 8B EC 83 E4 F8", 2},
+        {"prologue#3", "55 8B EC 83 E4 F8", 3},
+        {"wildcards", "8B EC ? E4 F8", 1},
+        {"nibbles", "5? 8B E? 83", 2},
+        {"sets", "[50-57] 8B [EB,EC] 83 [E0-E7]", 0},
+        {"loose", "? [80-8F] ? [80-8F] ?? F8", 2},
+        {"long", "", 0},
+        {"absent", "DE AD BE EF 00 11", 0},
+    };
+
+    for (auto [entry, signature, nth_match] : signatures) {
+        if (signature.empty()) {
+            std::stringstream run = {};
+            for (uint32_t i = 0; i < long_size; ++i) {
+                if (i % 9) {
+                    run << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << (int)long_byte(i) << ' ';
+                } else {
+                    run << "? ";
+                }
+            }
+
+            signature = run.str();
+        }
+
+        auto compiled = pattern::context(signature);
+
+        dll.clear_matches();
+        auto found = rva(dll.find_signature(compiled, ".text", nth_match));
+
+        // every engine has to agree with the one picked
+        for (const auto& [which, other_found] : dll.find_signature_each(compiled, ".text", nth_match)) {
+            ran.insert(which);
+
+            if (const auto& other = rva(other_found); other != found) {
+                std::cout << "[!] " << mode << ": " << entry << " engines disagree, " << pattern::describe(which) << " found " << other << '\n';
+                ++failures;
+            }
+        }
+
+        out["signatures/" + entry] = found;
+    }
+
+    // the patterns are picked so every engine is checked against the others
+    for (const auto which : pattern::engines) {
+        if (!ran.contains(which)) {
+            std::cout << "[!] " << mode << ": no pattern ran " << pattern::describe(which) << '\n';
+            ++failures;
+        }
+    }
+
+    const std::vector<std::tuple<std::string, std::string, std::string, size_t>> searches = {
+        {"engine", "VEngineClient014", ".text", 0},
+        {"engine#1", "VEngineClient014", ".text", 1},
+        {"engine#2", "VEngineClient014", ".text", 2},
+        {"engine#3", "VEngineClient014", ".text", 3},
+        {"engine-data", "VEngineClient014", ".data", 0},
+        {"tail", "Client014", ".text", 0},
+        {"short", "abc", ".text", 0},
+        {"absent", "VClientEntityList003", ".text", 0},
+    };
+
+    for (const auto& [entry, string, section, reference_instance] : searches) {
+        // a string which isn't there is a result like any other here
+        try {
+            out["string-search/" + entry] = rva(dll.find_string(string, section, reference_instance));
+        } catch (const std::runtime_error&) {
+            out["string-search/" + entry] = nullptr;
+        }
+    }
+
+    for (const auto& name : {"CreateInterface", "GetVersion", "Forwarded", "Absent"}) {
+        out["procedures/" + std::string {name}] = rva(dll.find_procedure(name));
+    }
+
+    if (!x64) {
+        for (const auto& [name, server_bounded] : {std::pair {"r_aspectratio", false}, {"cl_cmdrate", true}, {"sv_cheats", false}, {"absent", false}}) {
+            try {
+                out["convars/" + std::string {name}] = rva(dll.find_convar(name, server_bounded));
+            } catch (const std::runtime_error&) {
+                out["convars/" + std::string {name}] = nullptr;
+            }
+        }
+    }
+
+    return out;
+}
+}  // namespace detail
+}  // namespace tests
+
+/**
+ * Usage: <golden file> [--update]. Every layout is resolved from file,
+ * paged in and streamed, and each has to match the golden run
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <golden file> [--update]\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path golden_name = argv[1];
+    const auto update                       = (argc > 2) && (std::string_view {argv[2]} == "--update");
+
+    nlohmann::json golden = nlohmann::json::object();
+    if (!update) {
+        std::ifstream stream(golden_name);
+        golden = nlohmann::json::parse(stream);
+    }
+
+    nlohmann::json current = nlohmann::json::object();
+    size_t failures        = 0;
+
+    const auto path = std::filesystem::temp_directory_path() / ("altdumper_tests." + std::to_string(GetCurrentProcessId()) + ".dll");
+
+    try {
+        for (const auto x64 : {false, true}) {
+            const auto name = x64 ? "x64" : "x86";
+            tests::detail::plant(x64).write(path);
+
+            for (const auto streamed : {false, true}) {
+                const auto mode = std::string {name} + (streamed ? "/streamed" : "/paged");
+
+                modules::context dll(path.string());
+                dll.set_window(streamed ? tests::detail::window : 0);
+
+                const auto resolved = tests::detail::resolve(dll, x64, failures, mode);
+                if (!streamed) {
+                    current[name] = resolved;
+                }
+
+                if (update) {
+                    continue;
+                }
+
+                for (const auto& [entry, value] : resolved.items()) {
+                    const auto& expected = golden[name].contains(entry) ? golden[name][entry] : nlohmann::json("missing");
+                    if (expected != value) {
+                        std::cout << "[!] " << mode << ": " << entry << " resolved to " << value << ", golden run had " << expected << '\n';
+                        ++failures;
+                    }
+                }
+
+                if (resolved.size() != golden[name].size()) {
+                    std::cout << "[!] " << mode << ": " << resolved.size() << " entries, golden run had " << golden[name].size() << '\n';
+                    ++failures;
+                }
+            }
+        }
+    } catch (const std::exception& error) {
+        std::cout << "[!] " << error.what() << '\n';
+        ++failures;
+    }
+
+    std::error_code error = {};
+    std::filesystem::remove(path, error);
+
+    if (update) {
+        std::ofstream(golden_name) << std::setw(4) << current << '\n';
+        std::cout << "Golden file written to " << golden_name.string() << '\n';
+    }
+
+    std::cout << (failures ? "[!] " : "[+] ") << failures << " failure(s)" << std::endl;
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+// ===========================================